@@ -0,0 +1,644 @@
+/**
+ * BENCH_SORT.C - Banc d'essai en ligne de commande pour sorting.c
+ *
+ * Exécutable autonome (sans Raylib) qui pilote TimedSortGeneric sur
+ * plusieurs tailles, types, distributions et algorithmes, avec répétitions,
+ * chauffe, statistiques (min/médiane/moyenne/p95/max) et sortie table, CSV
+ * ou JSON.
+ *
+ * Exemple:
+ *   bench_sort --sizes 1000,100000 --types int,string --algos shell,quick \
+ *              --dists uniform,nearly --reps 7 --warmup 2 --format csv \
+ *              --output bench.csv
+ */
+
+#include "dataset.h"
+#include "pagealloc.h"
+#include "sorting.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_SIZES 32
+
+static const char *TYPE_KEYS[] = {"int", "float", "char", "string"};
+#define TYPE_KEY_COUNT 4
+
+// Clés des distributions, dans l'ordre de DataDistribution
+static const char *DIST_KEYS[DIST_COUNT] = {
+    "uniform", "sorted", "reversed", "nearly", "few", "organ", "zipf"};
+
+typedef enum { OUTPUT_TABLE, OUTPUT_CSV, OUTPUT_JSON } OutputFormat;
+
+typedef struct {
+  size_t sizes[BENCH_MAX_SIZES];
+  int size_count;
+  bool types[TYPE_KEY_COUNT];
+  bool dists[DIST_COUNT];
+  bool algos[SORT_COUNT];
+  int reps;
+  int warmup;
+  size_t max_quadratic; // Taille max des cas quadratiques (0 = illimité)
+  int threads;          // Threads de SORT_PARALLEL (0 = un par cœur)
+  int ext_mem_mb;       // Budget mémoire de SORT_EXTERNAL (0 = défaut)
+  bool counters;        // Capture des compteurs matériels
+  bool huge_pages;      // MADV_HUGEPAGE sur les grands tableaux
+  bool prefault;        // Défauts de page des copies pris avant la mesure
+  unsigned long long seed; // Graine de GenerateTypedData
+  OutputFormat format;
+  const char *output_path;
+  const char *input_path; // Jeu de données binaire (remplace la génération)
+} BenchConfig;
+
+typedef struct {
+  int type;
+  int dist;
+  size_t size;
+  int algo;
+  SortStats stats;
+  HwCounterSample counters; // Médiane par compteur des répétitions mesurées
+  bool sorted; // Trié et mêmes éléments que l'entrée (VerifySortedGeneric)
+  double speedup; // Médiane Quick Sort / médiane de l'algo (0 = inconnu)
+  char note[SORT_NOTE_SIZE]; // Note du dernier tri (choix de SORT_AUTO, ...)
+} BenchResult;
+
+// ==================== PARSING ====================
+
+// Clé courte d'un algorithme: premier mot de SORT_NAMES en minuscules
+static void AlgoKey(int algo, char *buffer, int buf_size) {
+  const char *name = SORT_NAMES[algo];
+  int i = 0;
+  while (name[i] && name[i] != ' ' && i < buf_size - 1) {
+    buffer[i] = (char)tolower((unsigned char)name[i]);
+    i++;
+  }
+  buffer[i] = '\0';
+}
+
+static int FindAlgo(const char *key) {
+  char buffer[32];
+  for (int a = 0; a < SORT_COUNT; a++) {
+    AlgoKey(a, buffer, sizeof(buffer));
+    if (strcmp(buffer, key) == 0)
+      return a;
+  }
+  return -1;
+}
+
+static int FindDist(const char *key) {
+  for (int d = 0; d < DIST_COUNT; d++) {
+    if (strcmp(DIST_KEYS[d], key) == 0)
+      return d;
+  }
+  return -1;
+}
+
+static int FindType(const char *key) {
+  for (int t = 0; t < TYPE_KEY_COUNT; t++) {
+    if (strcmp(TYPE_KEYS[t], key) == 0)
+      return t;
+  }
+  return -1;
+}
+
+// Découpe une liste "a,b,c" et appelle handler sur chaque élément
+static bool ParseList(const char *list, BenchConfig *cfg,
+                      bool (*handler)(BenchConfig *, const char *)) {
+  char buffer[512];
+  strncpy(buffer, list, sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = '\0';
+
+  for (char *tok = strtok(buffer, ","); tok; tok = strtok(NULL, ",")) {
+    if (!handler(cfg, tok))
+      return false;
+  }
+  return true;
+}
+
+// Taille positive, au-delà de INT_MAX acceptée
+static bool ParseSize(const char *tok, size_t *size) {
+  char *end = NULL;
+  unsigned long long value = strtoull(tok, &end, 10);
+  *size = (size_t)value;
+  return isdigit((unsigned char)tok[0]) && *end == '\0' && value > 0 &&
+         (unsigned long long)*size == value;
+}
+
+// "on" ou "off"
+static bool ParseSwitch(const char *arg, const char *val, bool *out) {
+  if (strcmp(val, "on") != 0 && strcmp(val, "off") != 0) {
+    fprintf(stderr, "%s attend on ou off: %s\n", arg, val);
+    return false;
+  }
+  *out = strcmp(val, "on") == 0;
+  return true;
+}
+
+static bool AddSize(BenchConfig *cfg, const char *tok) {
+  size_t size;
+  if (!ParseSize(tok, &size) || cfg->size_count >= BENCH_MAX_SIZES) {
+    fprintf(stderr, "Taille invalide: %s\n", tok);
+    return false;
+  }
+  cfg->sizes[cfg->size_count++] = size;
+  return true;
+}
+
+static bool AddType(BenchConfig *cfg, const char *tok) {
+  if (strcmp(tok, "all") == 0) {
+    for (int t = 0; t < TYPE_KEY_COUNT; t++)
+      cfg->types[t] = true;
+    return true;
+  }
+  int t = FindType(tok);
+  if (t < 0) {
+    fprintf(stderr, "Type inconnu: %s\n", tok);
+    return false;
+  }
+  cfg->types[t] = true;
+  return true;
+}
+
+static bool AddDist(BenchConfig *cfg, const char *tok) {
+  if (strcmp(tok, "all") == 0) {
+    for (int d = 0; d < DIST_COUNT; d++)
+      cfg->dists[d] = true;
+    return true;
+  }
+  int d = FindDist(tok);
+  if (d < 0) {
+    fprintf(stderr, "Distribution inconnue: %s\n", tok);
+    return false;
+  }
+  cfg->dists[d] = true;
+  return true;
+}
+
+static bool AddAlgo(BenchConfig *cfg, const char *tok) {
+  if (strcmp(tok, "all") == 0) {
+    for (int a = 0; a < SORT_COUNT; a++)
+      cfg->algos[a] = true;
+    return true;
+  }
+  int a = FindAlgo(tok);
+  if (a < 0) {
+    fprintf(stderr, "Algorithme inconnu: %s\n", tok);
+    return false;
+  }
+  cfg->algos[a] = true;
+  return true;
+}
+
+static void PrintUsage(const char *prog) {
+  char key[32];
+  printf("Usage: %s [options]\n\n", prog);
+  printf("  -n, --sizes LIST        Tailles (defaut: 1000,10000,100000)\n");
+  printf("  -t, --types LIST        int,float,char,string|all (defaut: all)\n");
+  printf("  -d, --dists LIST        ");
+  for (int d = 0; d < DIST_COUNT; d++)
+    printf("%s%s", DIST_KEYS[d], d < DIST_COUNT - 1 ? "," : "|all\n");
+  printf("                          (defaut: uniform)\n");
+  printf("  -a, --algos LIST        ");
+  for (int a = 0; a < SORT_COUNT; a++) {
+    AlgoKey(a, key, sizeof(key));
+    printf("%s%s", key, a < SORT_COUNT - 1 ? "," : "|all (defaut: all)\n");
+  }
+  printf("  -r, --reps N            Repetitions mesurees (defaut: 5)\n");
+  printf("  -w, --warmup N          Repetitions de chauffe (defaut: 1)\n");
+  printf("  -q, --max-quadratic N   Taille max Bubble/Insertion (et Quick "
+         "hors uniform),\n"
+         "                          0 = illimite (defaut: 50000)\n");
+  printf("  -j, --threads N         Threads du tri parallele (defaut: "
+         "%d)\n",
+         GetCpuCount());
+  printf("  -m, --ext-mem MB        Memoire du tri externe (defaut: %zu)\n",
+         GetExternalMemory() >> 20);
+  printf("  -c, --counters on|off   Compteurs materiels (perf_event, defaut: "
+         "on)\n");
+  printf("  -g, --hugepages on|off  Pages enormes pour les grands tableaux "
+         "(defaut: on)\n");
+  printf("  -p, --prefault on|off   Defauts de page des copies avant la "
+         "mesure (defaut: off)\n");
+  printf("  -s, --seed N            Graine aleatoire (defaut: time)\n");
+  printf("  -f, --format FMT        table|csv|json (defaut: table)\n");
+  printf("  -o, --output FILE       Fichier de sortie (defaut: stdout)\n");
+  printf("  -i, --input FILE        Jeu de donnees binaire (.sdt) a la place "
+         "de -n/-t/-d\n");
+  printf("  -h, --help              Affiche cette aide\n");
+}
+
+static bool ParseArgs(int argc, char **argv, BenchConfig *cfg) {
+  memset(cfg, 0, sizeof(BenchConfig));
+  cfg->reps = 5;
+  cfg->warmup = 1;
+  cfg->max_quadratic = 50000;
+  cfg->seed = (unsigned long long)time(NULL);
+  cfg->format = OUTPUT_TABLE;
+  cfg->counters = true;
+  cfg->huge_pages = true;
+
+  bool has_types = false, has_dists = false, has_algos = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+      PrintUsage(argv[0]);
+      exit(0);
+    }
+    if (i + 1 >= argc) {
+      fprintf(stderr, "Option sans valeur: %s\n", arg);
+      return false;
+    }
+    const char *val = argv[++i];
+
+    if (strcmp(arg, "-n") == 0 || strcmp(arg, "--sizes") == 0) {
+      if (!ParseList(val, cfg, AddSize))
+        return false;
+    } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--types") == 0) {
+      if (!ParseList(val, cfg, AddType))
+        return false;
+      has_types = true;
+    } else if (strcmp(arg, "-d") == 0 || strcmp(arg, "--dists") == 0) {
+      if (!ParseList(val, cfg, AddDist))
+        return false;
+      has_dists = true;
+    } else if (strcmp(arg, "-a") == 0 || strcmp(arg, "--algos") == 0) {
+      if (!ParseList(val, cfg, AddAlgo))
+        return false;
+      has_algos = true;
+    } else if (strcmp(arg, "-r") == 0 || strcmp(arg, "--reps") == 0) {
+      cfg->reps = atoi(val);
+    } else if (strcmp(arg, "-w") == 0 || strcmp(arg, "--warmup") == 0) {
+      cfg->warmup = atoi(val);
+    } else if (strcmp(arg, "-q") == 0 ||
+               strcmp(arg, "--max-quadratic") == 0) {
+      if (!ParseSize(val, &cfg->max_quadratic))
+        cfg->max_quadratic = 0;
+    } else if (strcmp(arg, "-j") == 0 || strcmp(arg, "--threads") == 0) {
+      cfg->threads = atoi(val);
+    } else if (strcmp(arg, "-m") == 0 || strcmp(arg, "--ext-mem") == 0) {
+      cfg->ext_mem_mb = atoi(val);
+    } else if (strcmp(arg, "-c") == 0 || strcmp(arg, "--counters") == 0) {
+      if (!ParseSwitch("--counters", val, &cfg->counters))
+        return false;
+    } else if (strcmp(arg, "-g") == 0 || strcmp(arg, "--hugepages") == 0) {
+      if (!ParseSwitch("--hugepages", val, &cfg->huge_pages))
+        return false;
+    } else if (strcmp(arg, "-p") == 0 || strcmp(arg, "--prefault") == 0) {
+      if (!ParseSwitch("--prefault", val, &cfg->prefault))
+        return false;
+    } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--seed") == 0) {
+      cfg->seed = strtoull(val, NULL, 10);
+    } else if (strcmp(arg, "-f") == 0 || strcmp(arg, "--format") == 0) {
+      if (strcmp(val, "table") == 0)
+        cfg->format = OUTPUT_TABLE;
+      else if (strcmp(val, "csv") == 0)
+        cfg->format = OUTPUT_CSV;
+      else if (strcmp(val, "json") == 0)
+        cfg->format = OUTPUT_JSON;
+      else {
+        fprintf(stderr, "Format inconnu: %s\n", val);
+        return false;
+      }
+    } else if (strcmp(arg, "-i") == 0 || strcmp(arg, "--input") == 0) {
+      cfg->input_path = val;
+    } else if (strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) {
+      cfg->output_path = val;
+    } else {
+      fprintf(stderr, "Option inconnue: %s\n", arg);
+      return false;
+    }
+  }
+
+  if (cfg->reps < 1 || cfg->warmup < 0) {
+    fprintf(stderr, "--reps doit etre >= 1 et --warmup >= 0\n");
+    return false;
+  }
+
+  // Valeurs par défaut
+  if (cfg->size_count == 0) {
+    cfg->sizes[0] = 1000;
+    cfg->sizes[1] = 10000;
+    cfg->sizes[2] = 100000;
+    cfg->size_count = 3;
+  }
+  if (!has_types)
+    AddType(cfg, "all");
+  if (!has_dists)
+    cfg->dists[DIST_UNIFORM] = true;
+  if (!has_algos)
+    AddAlgo(cfg, "all");
+  return true;
+}
+
+// ==================== STATISTIQUES ====================
+
+static int CompareLongLong(const void *a, const void *b) {
+  long long x = *(const long long *)a, y = *(const long long *)b;
+  return (x > y) - (x < y);
+}
+
+// Médiane de chaque compteur (HW_COUNTER_NA s'il manque à une répétition)
+static HwCounterSample MedianCounters(const HwCounterSample *samples,
+                                      int count) {
+  HwCounterSample median;
+  HwCountersClear(&median);
+  long long *values = (long long *)malloc(count * sizeof(long long));
+  if (!values)
+    return median;
+
+  for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+    int n = 0;
+    while (n < count && samples[n].value[c] != HW_COUNTER_NA) {
+      values[n] = samples[n].value[c];
+      n++;
+    }
+    if (n < count || n == 0)
+      continue;
+    qsort(values, n, sizeof(long long), CompareLongLong);
+    median.value[c] = values[n / 2];
+  }
+  free(values);
+  return median;
+}
+
+// ==================== SORTIE ====================
+
+static void PrintHeader(FILE *out, OutputFormat format) {
+  switch (format) {
+  case OUTPUT_TABLE:
+    fprintf(out,
+            "%-8s %-9s %10s  %-16s %15s %15s %15s %15s %15s %8s  %-3s %5s "
+            "%9s  %-8s  %s\n",
+            "type", "dist", "size", "algo", "min", "median", "mean", "p95",
+            "max", "x quick", "ok", "ipc", "faults", "isa", "note");
+    break;
+  case OUTPUT_CSV:
+    fprintf(out, "type,dist,size,algo,isa,reps,warmup,threads,min_s,median_s,"
+                 "mean_s,p95_s,max_s,stddev_s,ci_low_s,ci_high_s,"
+                 "speedup_vs_quick,sorted,cycles,instructions,branch_misses,"
+                 "cache_misses,minor_faults,major_faults,note\n");
+    break;
+  case OUTPUT_JSON:
+    fprintf(out, "[\n");
+    break;
+  }
+}
+
+static void PrintRow(FILE *out, const BenchConfig *cfg, const BenchResult *r,
+                     bool first) {
+  char key[32];
+  AlgoKey(r->algo, key, sizeof(key));
+  const SortStats *st = &r->stats;
+  int threads = cfg->threads > 0 ? cfg->threads : GetSortThreadCount();
+  const char *isa = SortKernelIsa(r->algo, (DataType)r->type);
+
+  switch (cfg->format) {
+  case OUTPUT_TABLE: {
+    char t[5][32], speedup[16] = "-", ipc[16] = "-", faults[24] = "-";
+    FormatTimeString(st->min, t[0], sizeof(t[0]));
+    FormatTimeString(st->median, t[1], sizeof(t[1]));
+    FormatTimeString(st->mean, t[2], sizeof(t[2]));
+    FormatTimeString(st->p95, t[3], sizeof(t[3]));
+    FormatTimeString(st->max, t[4], sizeof(t[4]));
+    if (r->speedup > 0)
+      snprintf(speedup, sizeof(speedup), "%.2f", r->speedup);
+    if (HwCountersIpc(&r->counters) > 0)
+      snprintf(ipc, sizeof(ipc), "%.2f", HwCountersIpc(&r->counters));
+    // Défauts de page mineurs et majeurs confondus
+    long long minor = r->counters.value[HW_MINOR_FAULTS];
+    long long major = r->counters.value[HW_MAJOR_FAULTS];
+    if (minor != HW_COUNTER_NA)
+      snprintf(faults, sizeof(faults), "%lld",
+               minor + (major != HW_COUNTER_NA ? major : 0));
+    fprintf(out,
+            "%-8s %-9s %10zu  %-16s %15s %15s %15s %15s %15s %8s  %-3s %5s "
+            "%9s  %-8s  %s\n",
+            TYPE_KEYS[r->type], DIST_KEYS[r->dist], r->size,
+            SORT_NAMES[r->algo], t[0], t[1], t[2], t[3], t[4], speedup,
+            r->sorted ? "oui" : "NON", ipc, faults, isa, r->note);
+    break;
+  }
+  case OUTPUT_CSV:
+    fprintf(out,
+            "%s,%s,%zu,%s,%s,%d,%d,%d,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,"
+            "%.4f,%d",
+            TYPE_KEYS[r->type], DIST_KEYS[r->dist], r->size, key, isa,
+            cfg->reps, cfg->warmup, threads, st->min, st->median, st->mean,
+            st->p95, st->max, st->stddev, st->ci_low, st->ci_high, r->speedup,
+            r->sorted ? 1 : 0);
+    // Colonnes vides pour les compteurs indisponibles
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+      if (r->counters.value[c] != HW_COUNTER_NA)
+        fprintf(out, ",%lld", r->counters.value[c]);
+      else
+        fprintf(out, ",");
+    }
+    // Les notes ne contiennent pas de guillemets
+    fprintf(out, ",\"%s\"\n", r->note);
+    break;
+  case OUTPUT_JSON:
+    fprintf(out,
+            "%s  {\"type\": \"%s\", \"dist\": \"%s\", \"size\": %zu, "
+            "\"algo\": \"%s\", \"isa\": \"%s\", "
+            "\"reps\": %d, \"warmup\": %d, \"threads\": %d, "
+            "\"min_s\": %.9f, \"median_s\": %.9f, \"mean_s\": %.9f, "
+            "\"p95_s\": %.9f, \"max_s\": %.9f, \"stddev_s\": %.9f, "
+            "\"ci_low_s\": %.9f, \"ci_high_s\": %.9f, "
+            "\"speedup_vs_quick\": %.4f, \"sorted\": %s",
+            first ? "" : ",\n", TYPE_KEYS[r->type], DIST_KEYS[r->dist],
+            r->size, key, isa, cfg->reps, cfg->warmup, threads, st->min,
+            st->median, st->mean, st->p95, st->max, st->stddev, st->ci_low,
+            st->ci_high, r->speedup, r->sorted ? "true" : "false");
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+      if (r->counters.value[c] != HW_COUNTER_NA)
+        fprintf(out, ", \"%s\": %lld", HW_COUNTER_KEYS[c],
+                r->counters.value[c]);
+      else
+        fprintf(out, ", \"%s\": null", HW_COUNTER_KEYS[c]);
+    }
+    fprintf(out, ", \"note\": \"%s\"}", r->note);
+    break;
+  }
+  fflush(out);
+}
+
+static void PrintFooter(FILE *out, OutputFormat format) {
+  if (format == OUTPUT_JSON)
+    fprintf(out, "\n]\n");
+}
+
+// ==================== MESURE ====================
+
+// Quick Sort (pivot = dernier élément) est quadratique hors données
+// uniformes: trié, inversé, doublons...
+static bool IsQuadratic(int algo, int dist) {
+  return algo == SORT_BUBBLE || algo == SORT_INSERTION ||
+         (algo == SORT_QUICK && dist != DIST_UNIFORM);
+}
+
+// Exécute warmup + reps tris sur des copies de la même entrée
+static bool RunOne(const BenchConfig *cfg, const GenericData *input, int algo,
+                   double *samples, HwCounterSample *counters, char *note) {
+  bool sorted = true;
+  int total = cfg->warmup + cfg->reps;
+
+  for (int r = 0; r < total; r++) {
+    GenericData *copy = CopyGenericData(input);
+    if (!copy)
+      return false;
+    double elapsed = TimedSortGeneric((SortAlgorithm)algo, copy);
+    if (r >= cfg->warmup) {
+      samples[r - cfg->warmup] = elapsed;
+      counters[r - cfg->warmup] = SortLastCounters();
+      snprintf(note, SORT_NOTE_SIZE, "%s", SortLastNote());
+      // Ordre et mêmes éléments que l'entrée (empreinte de génération)
+      if (VerifySortedGeneric(copy, input) != SORT_VERIFY_OK)
+        sorted = false;
+    }
+    FreeGenericData(copy);
+  }
+  return sorted;
+}
+
+// Mesure tous les algorithmes sur une entrée et affiche les lignes.
+// Renvoie le nombre de résultats non triés ou altérés.
+static int BenchInput(const BenchConfig *cfg, FILE *out,
+                      const GenericData *input, int t, int d, double *samples,
+                      HwCounterSample *counters, bool *first) {
+  size_t size = input->size;
+  int failures = 0;
+
+  // Toutes les mesures d'abord, pour calculer l'accélération par rapport à
+  // Quick Sort sur la même entrée
+  BenchResult results[SORT_COUNT];
+  int result_count = 0;
+  double quick_median = 0;
+
+  for (int a = 0; a < SORT_COUNT; a++) {
+    if (!cfg->algos[a] || !SortSupportsType((SortAlgorithm)a, (DataType)t))
+      continue;
+    if (IsQuadratic(a, d) && cfg->max_quadratic > 0 &&
+        size > cfg->max_quadratic) {
+      fprintf(stderr, "skip %s (%s, %s, %zu > --max-quadratic)\n",
+              SORT_NAMES[a], TYPE_KEYS[t], DIST_KEYS[d], size);
+      continue;
+    }
+
+    BenchResult *r = &results[result_count++];
+    r->type = t;
+    r->dist = d;
+    r->size = size;
+    r->algo = a;
+    r->sorted = RunOne(cfg, input, a, samples, counters, r->note);
+    r->stats = ComputeSortStats(samples, cfg->reps);
+    r->counters = MedianCounters(counters, cfg->reps);
+    if (a == SORT_QUICK)
+      quick_median = r->stats.median;
+    if (!r->sorted)
+      failures++;
+  }
+
+  for (int i = 0; i < result_count; i++) {
+    BenchResult *r = &results[i];
+    r->speedup = (quick_median > 0 && r->stats.median > 0)
+                     ? quick_median / r->stats.median
+                     : 0;
+    PrintRow(out, cfg, r, *first);
+    *first = false;
+  }
+  return failures;
+}
+
+int main(int argc, char **argv) {
+  BenchConfig cfg;
+  if (!ParseArgs(argc, argv, &cfg)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  FILE *out = stdout;
+  if (cfg.output_path) {
+    out = fopen(cfg.output_path, "w");
+    if (!out) {
+      fprintf(stderr, "Impossible d'ouvrir %s\n", cfg.output_path);
+      return 1;
+    }
+  }
+
+  double *samples = (double *)malloc(cfg.reps * sizeof(double));
+  HwCounterSample *counters =
+      (HwCounterSample *)malloc(cfg.reps * sizeof(HwCounterSample));
+  if (!samples || !counters)
+    return 1;
+
+  SetSortThreadCount(cfg.threads);
+  HwCountersEnable(cfg.counters);
+  PageAllocEnableHugePages(cfg.huge_pages);
+  PageAllocEnablePrefault(cfg.prefault);
+  SetExternalMemory(cfg.ext_mem_mb > 0 ? (size_t)cfg.ext_mem_mb << 20 : 0);
+  fprintf(stderr,
+          "bench_sort: seed=%llu reps=%d warmup=%d threads=%d isa=%s\n",
+          cfg.seed, cfg.reps, cfg.warmup, GetSortThreadCount(), SortIsaName());
+  if (cfg.algos[SORT_AUTO]) {
+    CalibrateAutoSort();
+    AutoSortThresholds th = GetAutoSortThresholds();
+    fprintf(stderr,
+            "auto: insertion<=%zu radix>=%zu parallel>=%zu (radix: >=%zu)\n",
+            th.insertion_max, th.radix_min, th.parallel_min,
+            th.parallel_radix_min);
+  }
+
+  PrintHeader(out, cfg.format);
+  bool first = true;
+  int failures = 0;
+
+  if (cfg.input_path) {
+    // Entrée projetée depuis le fichier: type et distribution de l'en-tête
+    GenericData *input = LoadDataset(cfg.input_path);
+    if (!input) {
+      fprintf(stderr, "Jeu de donnees illisible: %s\n", cfg.input_path);
+      return 1;
+    }
+    UpdateGenericDataChecksum(input); // Référence des vérifications
+    failures += BenchInput(&cfg, out, input, input->type, input->dist,
+                           samples, counters, &first);
+    FreeGenericData(input);
+  }
+
+  for (int t = 0; t < TYPE_KEY_COUNT && !cfg.input_path; t++) {
+    if (!cfg.types[t])
+      continue;
+    for (int d = 0; d < DIST_COUNT; d++) {
+      if (!cfg.dists[d])
+        continue;
+      for (int s = 0; s < cfg.size_count; s++) {
+        size_t size = cfg.sizes[s];
+        GenericData *input = GenerateTypedData(size, (DataType)t,
+                                               (DataDistribution)d, cfg.seed);
+        if (!input) {
+          fprintf(stderr, "Echec de generation (%s, %s, %zu)\n", TYPE_KEYS[t],
+                  DIST_KEYS[d], size);
+          continue;
+        }
+        failures +=
+            BenchInput(&cfg, out, input, t, d, samples, counters, &first);
+        FreeGenericData(input);
+      }
+    }
+  }
+
+  PrintFooter(out, cfg.format);
+  free(samples);
+  free(counters);
+  if (out != stdout)
+    fclose(out);
+
+  if (failures > 0) {
+    fprintf(stderr, "%d resultat(s) non trie(s) ou altere(s)\n", failures);
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * DATASET.C - Lecture (projection mémoire) et écriture des jeux de données
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "dataset.h"
+#include "pagealloc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Tampon stdio de l'écriture (grands blocs séquentiels)
+#define DATASET_IO_BUFFER (1 << 20)
+
+// Offsets des chaînes convertis par paquets avant écriture
+#define DATASET_OFFSET_CHUNK 4096
+
+typedef char DatasetHeaderCheck[sizeof(DatasetHeader) == DATASET_ALIGN ? 1
+                                                                        : -1];
+
+static uint64_t AlignUp(uint64_t offset) {
+  return (offset + DATASET_ALIGN - 1) / DATASET_ALIGN * DATASET_ALIGN;
+}
+
+// Taille d'un élément dans le fichier (offset 64 bits pour les chaînes)
+static size_t StoredElementSize(DataType type) {
+  return type == DATA_TYPE_STRING ? sizeof(uint64_t) : GenericElementSize(type);
+}
+
+static bool WritePadding(FILE *f, uint64_t from, uint64_t to) {
+  static const char zeros[DATASET_ALIGN] = {0};
+  return fwrite(zeros, 1, (size_t)(to - from), f) == (size_t)(to - from);
+}
+
+// Offsets puis caractères, dans l'ordre des pointeurs: le bloc écrit est
+// compact même si data partage le bloc d'une autre structure
+static bool WriteStrings(FILE *f, const GenericData *data,
+                         const DatasetHeader *h) {
+  uint64_t chunk[DATASET_OFFSET_CHUNK];
+  uint64_t offset = 0;
+  for (size_t i = 0; i < data->size;) {
+    int count = 0;
+    while (count < DATASET_OFFSET_CHUNK && i < data->size) {
+      chunk[count++] = offset;
+      offset += strlen(data->data.string_data[i++]) + 1;
+    }
+    if (fwrite(chunk, sizeof(uint64_t), (size_t)count, f) != (size_t)count)
+      return false;
+  }
+
+  uint64_t end = h->payload_offset + (uint64_t)data->size * sizeof(uint64_t);
+  if (!WritePadding(f, end, h->arena_offset))
+    return false;
+  for (size_t i = 0; i < data->size; i++) {
+    const char *s = data->data.string_data[i];
+    size_t len = strlen(s) + 1;
+    if (fwrite(s, 1, len, f) != len)
+      return false;
+  }
+  return true;
+}
+
+bool SaveDataset(const GenericData *data, const char *path) {
+  if (!data || !path)
+    return false;
+
+  DatasetHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, DATASET_MAGIC, sizeof(h.magic));
+  h.version = DATASET_VERSION;
+  h.byte_order = DATASET_BYTE_ORDER;
+  h.type = (uint32_t)data->type;
+  h.dist = (uint32_t)data->dist;
+  h.size = (uint64_t)data->size;
+  h.seed = data->seed;
+  h.payload_offset = DATASET_ALIGN;
+
+  uint64_t payload = h.size * StoredElementSize(data->type);
+  if (data->type == DATA_TYPE_STRING) {
+    for (size_t i = 0; i < data->size; i++)
+      h.arena_size += strlen(data->data.string_data[i]) + 1;
+    h.arena_offset = AlignUp(h.payload_offset + payload);
+  }
+
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return false;
+  setvbuf(f, NULL, _IOFBF, DATASET_IO_BUFFER);
+
+  bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+  if (ok && data->type == DATA_TYPE_STRING) {
+    ok = WriteStrings(f, data, &h);
+  } else if (ok) {
+    ok = fwrite(GenericDataPointer((GenericData *)data),
+                GenericElementSize(data->type), data->size, f) == data->size;
+  }
+
+  ok = (fclose(f) == 0) && ok;
+  if (!ok)
+    remove(path);
+  return ok;
+}
+
+// Projection privée du fichier entier (copie à l'écriture), NULL si
+// absent, vide ou non projetable
+static void *MapFile(const char *path, size_t *size) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return NULL;
+
+  void *view = NULL;
+  LARGE_INTEGER length;
+  if (GetFileSizeEx(file, &length) && length.QuadPart > 0 &&
+      (unsigned long long)length.QuadPart <= (size_t)-1) {
+    HANDLE mapping =
+        CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping) {
+      // La vue garde la projection ouverte après fermeture des handles
+      view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+      CloseHandle(mapping);
+    }
+    *size = (size_t)length.QuadPart;
+  }
+  CloseHandle(file);
+  return view;
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+
+  void *view = NULL;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0 &&
+      (unsigned long long)st.st_size <= (size_t)-1) {
+    view = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+      view = NULL;
+    *size = (size_t)st.st_size;
+  }
+  close(fd);
+  return view;
+#endif
+}
+
+void UnmapDataset(void *mapping, size_t size) {
+  if (!mapping)
+    return;
+#ifdef _WIN32
+  UnmapViewOfFile(mapping);
+#else
+  munmap(mapping, size);
+#endif
+}
+
+// Vérifie que l'en-tête et les sections tiennent dans les size octets
+static bool ValidHeader(const DatasetHeader *h, size_t size) {
+  if (memcmp(h->magic, DATASET_MAGIC, sizeof(h->magic)) != 0 ||
+      h->version != DATASET_VERSION || h->byte_order != DATASET_BYTE_ORDER ||
+      h->type > DATA_TYPE_STRING || h->dist >= DIST_COUNT ||
+      h->size > SIZE_MAX / sizeof(uint64_t))
+    return false;
+  if (h->payload_offset < sizeof(DatasetHeader) ||
+      h->payload_offset % DATASET_ALIGN != 0 || h->payload_offset > size)
+    return false;
+
+  uint64_t payload = h->size * StoredElementSize((DataType)h->type);
+  if (payload > size - h->payload_offset)
+    return false;
+  if (h->type != DATA_TYPE_STRING)
+    return true;
+
+  // Chaînes: bloc après le tableau d'offsets, terminé par un '\0'
+  return h->arena_offset >= h->payload_offset + payload &&
+         h->arena_offset <= size && h->arena_size <= size - h->arena_offset &&
+         (h->size == 0 || h->arena_size > 0);
+}
+
+GenericData *LoadDataset(const char *path) {
+  size_t size = 0;
+  char *base = (char *)MapFile(path, &size);
+  if (!base)
+    return NULL;
+
+  const DatasetHeader *h = (const DatasetHeader *)base;
+  GenericData *gd = NULL;
+  if (size < sizeof(DatasetHeader) || !ValidHeader(h, size) ||
+      !(gd = (GenericData *)malloc(sizeof(GenericData)))) {
+    UnmapDataset(base, size);
+    return NULL;
+  }
+
+  gd->type = (DataType)h->type;
+  gd->size = (size_t)h->size;
+  gd->seed = h->seed;
+  gd->dist = (DataDistribution)h->dist;
+  gd->has_checksum = false; // Calculée à la demande (lecture complète)
+  gd->checksum = 0;
+  gd->string_arena = NULL;
+  gd->arena_size = 0;
+  gd->mapping = base;
+  gd->mapping_size = size;
+
+  char *payload = base + h->payload_offset;
+  switch (gd->type) {
+  case DATA_TYPE_INT:
+    gd->data.int_data = (long long *)payload;
+    break;
+  case DATA_TYPE_FLOAT:
+    gd->data.float_data = (double *)payload;
+    break;
+  case DATA_TYPE_CHAR:
+    gd->data.char_data = payload;
+    break;
+  case DATA_TYPE_STRING: {
+    // Seule étape linéaire: offsets -> pointeurs, bornés par le bloc
+    const uint64_t *offsets = (const uint64_t *)payload;
+    char *arena = base + h->arena_offset;
+    bool ok = h->size == 0 || arena[h->arena_size - 1] == '\0';
+    gd->data.string_data = (char **)PageAlloc(gd->size * sizeof(char *));
+    ok = ok && gd->data.string_data;
+    for (size_t i = 0; ok && i < gd->size; i++) {
+      ok = offsets[i] < h->arena_size;
+      gd->data.string_data[i] = arena + offsets[i];
+    }
+    if (!ok) {
+      PageFree(gd->data.string_data, gd->size * sizeof(char *));
+      free(gd);
+      UnmapDataset(base, size);
+      return NULL;
+    }
+    gd->string_arena = arena;
+    gd->arena_size = (size_t)h->arena_size;
+    break;
+  }
+  }
+  return gd;
+}
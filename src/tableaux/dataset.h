@@ -0,0 +1,57 @@
+/**
+ * DATASET.H - Format binaire des jeux de données (projection mémoire)
+ *
+ * Un fichier contient un seul GenericData, directement utilisable une fois
+ * projeté en mémoire (mmap / MapViewOfFile), sans analyse des valeurs:
+ *
+ *   [0, 64)             en-tête DatasetHeader
+ *   [64, ...)           tableau brut: long long, double ou char; pour les
+ *                       chaînes, un offset 64 bits par élément dans le bloc
+ *   [arena_offset, ...) chaînes: caractères + terminateurs (aligné sur 64)
+ *
+ * Les valeurs sont stockées dans l'ordre d'octets de la machine qui écrit;
+ * un fichier d'une autre architecture est refusé au chargement.
+ */
+
+#ifndef DATASET_H
+#define DATASET_H
+
+#include "sorting.h"
+#include <stdint.h>
+
+#define DATASET_MAGIC "SDTRIDAT" // 8 octets, sans terminateur
+#define DATASET_VERSION 1
+#define DATASET_BYTE_ORDER 0x01020304u
+#define DATASET_ALIGN 64 // En-tête et début des sections
+
+// Extension proposée pour les fichiers de données
+#define DATASET_EXTENSION ".sdt"
+
+typedef struct {
+  char magic[8];           // DATASET_MAGIC
+  uint32_t version;        // DATASET_VERSION
+  uint32_t byte_order;     // DATASET_BYTE_ORDER tel qu'écrit par l'auteur
+  uint32_t type;           // DataType
+  uint32_t dist;           // DataDistribution
+  uint64_t size;           // Nombre d'éléments
+  uint64_t seed;           // Graine de génération (0 = saisie/import)
+  uint64_t payload_offset; // Début du tableau (DATASET_ALIGN)
+  uint64_t arena_offset;   // Début du bloc de chaînes (0 si pas de chaînes)
+  uint64_t arena_size;     // Taille du bloc de chaînes en octets
+} DatasetHeader;
+
+// Écrit data dans path (fichier remplacé). Les chaînes sont réécrites dans
+// l'ordre des pointeurs, en un bloc compact. Renvoie false en cas d'erreur.
+bool SaveDataset(const GenericData *data, const char *path);
+
+// Projette path en mémoire (copie à l'écriture: les modifications ne
+// touchent pas le fichier) et renvoie un GenericData qui pointe dans la
+// projection. Seul le tableau de pointeurs des chaînes est alloué.
+// NULL si le fichier est absent, tronqué ou invalide. À libérer avec
+// FreeGenericData.
+GenericData *LoadDataset(const char *path);
+
+// Retire une projection créée par LoadDataset (appelée par FreeGenericData)
+void UnmapDataset(void *mapping, size_t size);
+
+#endif // DATASET_H
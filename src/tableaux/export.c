@@ -0,0 +1,539 @@
+/**
+ * EXPORT.C - Export des résultats de tri dans un thread d'arrière-plan
+ */
+
+#include "export.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <stdint.h>
+#endif
+
+// Accès atomiques à l'état partagé avec l'UI (C99: builtins GCC)
+#if defined(__GNUC__)
+#define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define ATOMIC_LOAD(p) (*(p))
+#define ATOMIC_STORE(p, v) (*(p) = (v))
+#endif
+
+// Tampon d'écriture: le fichier ne reçoit que des blocs de cette taille
+#define EXPORT_BUFFER (1 << 20)
+
+// Éléments écrits entre deux publications de progression (puissance de 2)
+#define EXPORT_PROGRESS_STEP 4096
+
+// Place réservée pour un nombre formaté ("%.2f" de 1e308 compris)
+#define EXPORT_NUMBER_MAX 320
+
+const char *EXPORT_FORMAT_NAMES[EXPORT_FORMAT_COUNT] = {"TXT", "CSV", "JSON"};
+const char *EXPORT_EXTENSIONS[EXPORT_FORMAT_COUNT] = {".txt", ".csv",
+                                                      ".json"};
+
+// Clés des types et statuts (CSV/JSON), comme celles de bench_sort
+static const char *TYPE_KEYS[] = {"int", "float", "char", "string"};
+static const char *STATUS_KEYS[] = {"not_run", "running", "done",
+                                    "not_applicable"};
+
+// ==================== ÉCRITURE TAMPONNÉE ====================
+
+typedef struct {
+  FILE *file;
+  char *buf;
+  size_t len;
+  bool ok; // Faux dès la première écriture en échec
+} ExportWriter;
+
+static void Flush(ExportWriter *w) {
+  if (w->len > 0 && w->ok)
+    w->ok = fwrite(w->buf, 1, w->len, w->file) == w->len;
+  w->len = 0;
+}
+
+// Garantit n octets libres (n <= EXPORT_BUFFER) à la fin du tampon
+static inline char *Reserve(ExportWriter *w, size_t n) {
+  if (w->len + n > EXPORT_BUFFER)
+    Flush(w);
+  return w->buf + w->len;
+}
+
+static void PutBytes(ExportWriter *w, const char *s, size_t n) {
+  while (n > 0) {
+    size_t chunk = n < EXPORT_BUFFER ? n : EXPORT_BUFFER;
+    memcpy(Reserve(w, chunk), s, chunk);
+    w->len += chunk;
+    s += chunk;
+    n -= chunk;
+  }
+}
+
+static inline void PutChar(ExportWriter *w, char c) {
+  *Reserve(w, 1) = c;
+  w->len++;
+}
+
+static void PutText(ExportWriter *w, const char *s) {
+  PutBytes(w, s, strlen(s));
+}
+
+// En-têtes et lignes de résultats uniquement (jamais par élément)
+static void PutFormat(ExportWriter *w, const char *fmt, ...) {
+  char line[512];
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(line, sizeof(line), fmt, args);
+  va_end(args);
+  if (len > 0)
+    PutBytes(w, line, (size_t)len < sizeof(line) ? (size_t)len
+                                                 : sizeof(line) - 1);
+}
+
+// ==================== FORMATAGE DES NOMBRES ====================
+
+static const char DIGIT_PAIRS[] = "00010203040506070809"
+                                  "10111213141516171819"
+                                  "20212223242526272829"
+                                  "30313233343536373839"
+                                  "40414243444546474849"
+                                  "50515253545556575859"
+                                  "60616263646566676869"
+                                  "70717273747576777879"
+                                  "80818283848586878889"
+                                  "90919293949596979899";
+
+// Écrit v en décimal à partir de p (deux chiffres par division), renvoie la
+// longueur
+static int FormatUnsigned(char *p, unsigned long long v) {
+  char tmp[20];
+  int n = 0;
+  while (v >= 100) {
+    unsigned d = (unsigned)(v % 100) * 2;
+    v /= 100;
+    tmp[n++] = DIGIT_PAIRS[d + 1];
+    tmp[n++] = DIGIT_PAIRS[d];
+  }
+  if (v >= 10) {
+    tmp[n++] = DIGIT_PAIRS[v * 2 + 1];
+    tmp[n++] = DIGIT_PAIRS[v * 2];
+  } else {
+    tmp[n++] = (char)('0' + v);
+  }
+  for (int i = 0; i < n; i++)
+    p[i] = tmp[n - 1 - i];
+  return n;
+}
+
+static int FormatInt(char *p, long long v) {
+  if (v < 0) {
+    *p = '-';
+    return 1 + FormatUnsigned(p + 1, 0ULL - (unsigned long long)v);
+  }
+  return FormatUnsigned(p, (unsigned long long)v);
+}
+
+// Équivalent exact de "%.2f" sous 2^53 centièmes (snprintf au-delà, et pour
+// inf/nan): |v| = m * 2^-shift, centièmes = m * 100 / 2^shift arrondis au
+// plus proche, pair en cas d'égalité comme printf
+static int FormatFixed2(char *p, double v) {
+  double a = fabs(v);
+  if (!(a < 90071992547409.0))
+    return snprintf(p, EXPORT_NUMBER_MAX, "%.2f", v);
+
+  int e;
+  unsigned long long m = (unsigned long long)ldexp(frexp(a, &e), 53);
+  int shift = 53 - e; // >= 7 puisque a < 2^47
+  unsigned long long scaled = m * 100; // < 2^60
+  unsigned long long cents = 0;        // shift >= 64: a * 100 < 1/2
+  if (shift < 64) {
+    unsigned long long rest = scaled & ((1ULL << shift) - 1);
+    unsigned long long half = 1ULL << (shift - 1);
+    cents = scaled >> shift;
+    if (rest > half || (rest == half && (cents & 1)))
+      cents++;
+  }
+
+  int n = 0;
+  if (signbit(v))
+    p[n++] = '-';
+  n += FormatUnsigned(p + n, cents / 100);
+  unsigned d = (unsigned)(cents % 100) * 2;
+  p[n++] = '.';
+  p[n++] = DIGIT_PAIRS[d];
+  p[n++] = DIGIT_PAIRS[d + 1];
+  return n;
+}
+
+// ==================== VALEURS ====================
+
+// Champ CSV: entre guillemets (doublés) s'il contient un séparateur. s n'est
+// pas forcément terminé (caractère isolé)
+static void PutCsvField(ExportWriter *w, const char *s, size_t len) {
+  bool quoted = false;
+  for (size_t i = 0; i < len && !quoted; i++)
+    quoted = s[i] == ',' || s[i] == '"' || s[i] == '\r' || s[i] == '\n';
+  if (!quoted) {
+    PutBytes(w, s, len);
+    return;
+  }
+  PutChar(w, '"');
+  for (size_t i = 0; i < len; i++) {
+    if (s[i] == '"')
+      PutChar(w, '"');
+    PutChar(w, s[i]);
+  }
+  PutChar(w, '"');
+}
+
+// Chaîne JSON: guillemets, antislash et caractères de contrôle échappés; les
+// suites de caractères sûrs sont recopiées d'un bloc
+static void PutJsonString(ExportWriter *w, const char *s, size_t len) {
+  size_t start = 0;
+  PutChar(w, '"');
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = (unsigned char)s[i];
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    PutBytes(w, s + start, i - start);
+    start = i + 1;
+    char *p = Reserve(w, 6);
+    if (c >= 0x20) {
+      p[0] = '\\';
+      p[1] = (char)c;
+      w->len += 2;
+    } else {
+      memcpy(p, "\\u00", 4);
+      p[4] = "0123456789abcdef"[c >> 4];
+      p[5] = "0123456789abcdef"[c & 15];
+      w->len += 6;
+    }
+  }
+  PutBytes(w, s + start, len - start);
+  PutChar(w, '"');
+}
+
+static void PutValue(ExportWriter *w, ExportFormat format,
+                     const GenericData *data, size_t i) {
+  switch (data->type) {
+  case DATA_TYPE_INT:
+    w->len +=
+        FormatInt(Reserve(w, EXPORT_NUMBER_MAX), data->data.int_data[i]);
+    break;
+  case DATA_TYPE_FLOAT: {
+    double v = data->data.float_data[i];
+    if (format == EXPORT_JSON && !isfinite(v))
+      PutText(w, "null"); // Pas d'infini ni de NaN en JSON
+    else
+      w->len += FormatFixed2(Reserve(w, EXPORT_NUMBER_MAX), v);
+    break;
+  }
+  case DATA_TYPE_CHAR:
+    if (format == EXPORT_CSV)
+      PutCsvField(w, &data->data.char_data[i], 1);
+    else if (format == EXPORT_JSON)
+      PutJsonString(w, &data->data.char_data[i], 1);
+    else
+      PutChar(w, data->data.char_data[i]);
+    break;
+  case DATA_TYPE_STRING: {
+    const char *s = data->data.string_data[i];
+    size_t len = strlen(s);
+    if (format == EXPORT_CSV)
+      PutCsvField(w, s, len);
+    else if (format == EXPORT_JSON)
+      PutJsonString(w, s, len);
+    else
+      PutBytes(w, s, len);
+    break;
+  }
+  }
+}
+
+// ==================== SECTIONS ====================
+
+// Publie la progression (appelée toutes les EXPORT_PROGRESS_STEP valeurs);
+// false si l'UI demande l'arrêt
+static bool ExportPublish(ResultExport *ex, long long done) {
+  ATOMIC_STORE(&ex->written, done);
+  return !ATOMIC_LOAD(&ex->should_stop);
+}
+
+// Liste de valeurs séparées par ", ", 10 par ligne (TXT et JSON)
+static bool PutValueList(ExportWriter *w, ResultExport *ex,
+                         const GenericData *data, long long *done) {
+  for (size_t i = 0; i < data->size; i++) {
+    PutValue(w, ex->format, data, i);
+    if (i < data->size - 1) {
+      // Deux octets: plus rapide qu'un appel à memcpy
+      PutChar(w, ',');
+      PutChar(w, ' ');
+    }
+    if ((i + 1) % 10 == 0)
+      PutChar(w, '\n');
+    if ((++*done & (EXPORT_PROGRESS_STEP - 1)) == 0 &&
+        !ExportPublish(ex, *done))
+      return false;
+  }
+  return true;
+}
+
+// Compteurs matériels d'un résultat: "cle=valeur" (TXT, disponibles
+// seulement), colonnes vides (CSV) ou null (JSON) si indisponibles
+static void PutCounters(ExportWriter *w, ExportFormat format,
+                        const HwCounterSample *counters) {
+  for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+    long long value = counters->value[c];
+    switch (format) {
+    case EXPORT_TXT:
+      if (value != HW_COUNTER_NA)
+        PutFormat(w, " %s=%lld", HW_COUNTER_KEYS[c], value);
+      break;
+    case EXPORT_CSV:
+      PutChar(w, ',');
+      if (value != HW_COUNTER_NA)
+        w->len += FormatInt(Reserve(w, EXPORT_NUMBER_MAX), value);
+      break;
+    default:
+      if (value != HW_COUNTER_NA)
+        PutFormat(w, ", \"%s\": %lld", HW_COUNTER_KEYS[c], value);
+      else
+        PutFormat(w, ", \"%s\": null", HW_COUNTER_KEYS[c]);
+      break;
+    }
+  }
+}
+
+static bool HasCounters(const HwCounterSample *counters) {
+  for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+    if (counters->value[c] != HW_COUNTER_NA)
+      return true;
+  }
+  return false;
+}
+
+static bool WriteTxt(ExportWriter *w, ResultExport *ex, const char *title) {
+  PutText(w, "========================================\n");
+  PutText(w, "RESULTATS DES TRIS\n");
+  PutText(w, "========================================\n");
+  PutFormat(w, "Taille du tableau: %zu elements\n", ex->size);
+  PutFormat(w, "Type de donnees: %s\n", title);
+  PutText(w, "\n--- TEMPS DE TRI ---\n");
+
+  for (int i = 0; i < SORT_COUNT; i++) {
+    const ExportResult *r = &ex->results[i];
+    switch (r->status) {
+    case EXPORT_NOT_APPLICABLE:
+      PutFormat(w, "%-15s : Non applicable\n", SORT_NAMES[i]);
+      break;
+    case EXPORT_DONE:
+      PutFormat(w, "%-15s : %.3f ms [%s] %s\n", SORT_NAMES[i], r->time_ms,
+                r->isa, r->note);
+      if (HasCounters(&r->counters)) {
+        PutText(w, "                 ");
+        PutCounters(w, EXPORT_TXT, &r->counters);
+        PutChar(w, '\n');
+      }
+      break;
+    case EXPORT_RUNNING:
+      PutFormat(w, "%-15s : En cours...\n", SORT_NAMES[i]);
+      break;
+    case EXPORT_NOT_RUN:
+      PutFormat(w, "%-15s : Non execute\n", SORT_NAMES[i]);
+      break;
+    }
+  }
+
+  long long done = 0;
+  const GenericData *sections[2] = {ex->before, ex->after};
+  const char *headers[2] = {"\n--- DONNEES AVANT TRI ---\n",
+                            "\n--- DONNEES APRES TRI ---\n"};
+  for (int s = 0; s < 2; s++) {
+    PutText(w, headers[s]);
+    if (sections[s] && sections[s]->size > 0) {
+      if (!PutValueList(w, ex, sections[s], &done))
+        return false;
+      PutChar(w, '\n');
+    }
+  }
+  PutText(w, "\n========================================\n");
+  return true;
+}
+
+// Deux tables: résultats par algorithme, puis index/avant/après
+static bool WriteCsv(ExportWriter *w, ResultExport *ex) {
+  PutText(w, "algo,status,time_ms,isa,note,cycles,instructions,branch_misses,"
+             "cache_misses,minor_faults,major_faults\n");
+  for (int i = 0; i < SORT_COUNT; i++) {
+    const ExportResult *r = &ex->results[i];
+    PutFormat(w, "%s,%s,", SORT_NAMES[i], STATUS_KEYS[r->status]);
+    if (r->status == EXPORT_DONE)
+      PutFormat(w, "%.3f", r->time_ms);
+    PutFormat(w, ",%s,", r->status == EXPORT_DONE ? r->isa : "");
+    PutCsvField(w, r->note, strlen(r->note));
+    PutCounters(w, EXPORT_CSV, &r->counters);
+    PutChar(w, '\n');
+  }
+
+  PutText(w, "\nindex,before,after\n");
+  size_t before = ex->before ? ex->before->size : 0;
+  size_t after = ex->after ? ex->after->size : 0;
+  size_t rows = before > after ? before : after;
+  long long done = 0;
+  for (size_t i = 0; i < rows; i++) {
+    w->len += FormatInt(Reserve(w, EXPORT_NUMBER_MAX), (long long)i);
+    PutChar(w, ',');
+    if (i < before)
+      PutValue(w, EXPORT_CSV, ex->before, i);
+    PutChar(w, ',');
+    if (i < after)
+      PutValue(w, EXPORT_CSV, ex->after, i);
+    PutChar(w, '\n');
+    done += (i < before) + (i < after);
+    if (((i + 1) & (EXPORT_PROGRESS_STEP - 1)) == 0 &&
+        !ExportPublish(ex, done))
+      return false;
+  }
+  return true;
+}
+
+static bool WriteJson(ExportWriter *w, ResultExport *ex) {
+  PutFormat(w, "{\n  \"size\": %zu,\n  \"type\": \"%s\",\n  \"results\": [\n",
+            ex->size, TYPE_KEYS[ex->type]);
+  for (int i = 0; i < SORT_COUNT; i++) {
+    const ExportResult *r = &ex->results[i];
+    PutFormat(w, "    {\"algo\": \"%s\", \"status\": \"%s\", ", SORT_NAMES[i],
+              STATUS_KEYS[r->status]);
+    if (r->status == EXPORT_DONE)
+      PutFormat(w, "\"time_ms\": %.3f, \"isa\": \"%s\", ", r->time_ms, r->isa);
+    PutText(w, "\"note\": ");
+    PutJsonString(w, r->note, strlen(r->note));
+    PutCounters(w, EXPORT_JSON, &r->counters);
+    PutText(w, i < SORT_COUNT - 1 ? "},\n" : "}\n");
+  }
+  PutText(w, "  ],\n");
+
+  long long done = 0;
+  const GenericData *sections[2] = {ex->before, ex->after};
+  const char *keys[2] = {"before", "after"};
+  for (int s = 0; s < 2; s++) {
+    PutFormat(w, "  \"%s\": [", keys[s]);
+    if (sections[s] && !PutValueList(w, ex, sections[s], &done))
+      return false;
+    PutText(w, s == 0 ? "],\n" : "]\n");
+  }
+  PutText(w, "}\n");
+  return true;
+}
+
+// ==================== THREAD D'EXPORT ====================
+
+static void RunResultExport(ResultExport *ex) {
+  ExportWriter w = {NULL, NULL, 0, true};
+  static const char *TYPE_TITLES[] = {"Entiers", "Reels", "Caracteres",
+                                      "Chaines"};
+  bool complete = false;
+
+  w.file = fopen(ex->path, "w");
+  w.buf = (char *)malloc(EXPORT_BUFFER);
+  if (w.file && w.buf) {
+    // Le tampon est déjà plein à chaque écriture: pas de copie stdio
+    setvbuf(w.file, NULL, _IONBF, 0);
+    switch (ex->format) {
+    case EXPORT_TXT:
+      complete = WriteTxt(&w, ex, TYPE_TITLES[ex->type]);
+      break;
+    case EXPORT_CSV:
+      complete = WriteCsv(&w, ex);
+      break;
+    default:
+      complete = WriteJson(&w, ex);
+      break;
+    }
+    Flush(&w);
+  }
+
+  bool closed = w.file && fclose(w.file) == 0;
+  free(w.buf);
+  ex->ok = complete && w.ok && closed;
+  ATOMIC_STORE(&ex->written, ex->total);
+  ATOMIC_STORE(&ex->finished, 1);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI ExportThreadFunc(LPVOID arg) {
+  RunResultExport((ResultExport *)arg);
+  return 0;
+}
+#else
+static void *ExportThreadFunc(void *arg) {
+  RunResultExport((ResultExport *)arg);
+  return NULL;
+}
+#endif
+
+static void JoinExportThread(ResultExport *ex) {
+  if (ex->thread) {
+#ifdef _WIN32
+    WaitForSingleObject(ex->thread, INFINITE);
+    CloseHandle(ex->thread);
+#else
+    pthread_join((pthread_t)(uintptr_t)ex->thread, NULL);
+#endif
+    ex->thread = NULL;
+  }
+  ex->active = false;
+}
+
+bool StartResultExport(ResultExport *ex) {
+  if (ex->active)
+    return false;
+
+  ex->finished = 0;
+  ex->should_stop = 0;
+  ex->written = 0;
+  ex->total = (long long)((ex->before ? ex->before->size : 0) +
+                          (ex->after ? ex->after->size : 0));
+  ex->ok = false;
+  ex->active = true;
+
+#ifdef _WIN32
+  ex->thread = CreateThread(NULL, 0, ExportThreadFunc, ex, 0, NULL);
+#else
+  pthread_t tid;
+  if (pthread_create(&tid, NULL, ExportThreadFunc, ex) == 0)
+    ex->thread = (void *)(uintptr_t)tid;
+  else
+    ex->thread = NULL;
+#endif
+  if (!ex->thread) // Pas de thread: export exécuté sur place
+    RunResultExport(ex);
+  return true;
+}
+
+float ResultExportProgress(const ResultExport *ex) {
+  if (!ex->active || ex->total <= 0)
+    return ex->active ? 0.0f : 1.0f;
+  return (float)ATOMIC_LOAD(&ex->written) / (float)ex->total;
+}
+
+bool PollResultExport(ResultExport *ex, bool *ok) {
+  if (!ex->active || !ATOMIC_LOAD(&ex->finished))
+    return false;
+  JoinExportThread(ex);
+  *ok = ex->ok;
+  return true;
+}
+
+void CancelResultExport(ResultExport *ex) {
+  if (!ex->active)
+    return;
+  ATOMIC_STORE(&ex->should_stop, 1);
+  JoinExportThread(ex);
+}
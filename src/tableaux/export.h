@@ -0,0 +1,77 @@
+/**
+ * EXPORT.H - Export des résultats de tri (TXT, CSV, JSON) en arrière-plan
+ *
+ * L'écriture se fait dans un thread dédié, par grands blocs, avec un
+ * formatage des nombres sans printf: l'UI ne fait que lancer l'export,
+ * afficher sa progression et récupérer le résultat.
+ */
+
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include "sorting.h"
+
+typedef enum {
+  EXPORT_TXT,
+  EXPORT_CSV,
+  EXPORT_JSON,
+  EXPORT_FORMAT_COUNT
+} ExportFormat;
+
+// Libellés et extensions, dans l'ordre de ExportFormat
+extern const char *EXPORT_FORMAT_NAMES[EXPORT_FORMAT_COUNT];
+extern const char *EXPORT_EXTENSIONS[EXPORT_FORMAT_COUNT];
+
+typedef enum {
+  EXPORT_NOT_RUN,
+  EXPORT_RUNNING,
+  EXPORT_DONE,
+  EXPORT_NOT_APPLICABLE
+} ExportStatus;
+
+// Résultat d'un algorithme, recopié au lancement (l'UI peut continuer)
+typedef struct {
+  ExportStatus status;
+  double time_ms;
+  const char *isa; // Chaîne statique (SortKernelIsa)
+  char note[SORT_NOTE_SIZE];
+  HwCounterSample counters; // HW_COUNTER_NA si indisponibles
+} ExportResult;
+
+typedef struct {
+  // Rempli par l'appelant avant StartResultExport
+  ExportFormat format;
+  char path[256];
+  DataType type;
+  size_t size;
+  ExportResult results[SORT_COUNT];
+  // Données lues par le thread: ni libérées ni modifiées avant la fin de
+  // l'export (sinon CancelResultExport). NULL = section vide.
+  const GenericData *before;
+  const GenericData *after;
+
+  // État interne
+  void *thread;
+  bool active;                // Lancé et pas encore récupéré
+  volatile int finished;      // Écrit par le thread
+  volatile int should_stop;   // Écrit par l'UI
+  volatile long long written; // Éléments écrits (avant + après)
+  long long total;
+  bool ok;
+} ResultExport;
+
+// Lance l'écriture de ex->path dans un thread (sur place si le thread ne
+// peut pas être créé). false si un export est déjà en cours.
+bool StartResultExport(ResultExport *ex);
+
+// Avancement de l'export en cours (0..1)
+float ResultExportProgress(const ResultExport *ex);
+
+// Vrai une seule fois, quand l'export lancé est terminé: le thread est
+// rejoint et *ok reçoit le résultat de l'écriture
+bool PollResultExport(ResultExport *ex, bool *ok);
+
+// Interrompt l'export en cours (fichier partiel) et attend le thread
+void CancelResultExport(ResultExport *ex);
+
+#endif // EXPORT_H
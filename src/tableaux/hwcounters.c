@@ -0,0 +1,145 @@
+/**
+ * HWCOUNTERS.C - Compteurs matériels (perf_event_open sous Linux)
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE // syscall()
+#endif
+
+#include "hwcounters.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char *HW_COUNTER_KEYS[HW_COUNTER_COUNT] = {
+    "cycles",       "instructions", "branch_misses",
+    "cache_misses", "minor_faults", "major_faults"};
+
+static volatile int hw_enabled = 1;
+// Mis à 1 quand le noyau refuse un compteur: plus d'appel système pour lui
+static volatile int hw_refused[HW_COUNTER_COUNT];
+
+void HwCountersEnable(bool enabled) { hw_enabled = enabled; }
+
+void HwCountersClear(HwCounterSample *sample) {
+  for (int i = 0; i < HW_COUNTER_COUNT; i++)
+    sample->value[i] = HW_COUNTER_NA;
+}
+
+double HwCountersIpc(const HwCounterSample *sample) {
+  long long cycles = sample->value[HW_CYCLES];
+  long long instructions = sample->value[HW_INSTRUCTIONS];
+  return (cycles > 0 && instructions >= 0) ? (double)instructions / cycles
+                                           : 0;
+}
+
+#ifdef __linux__
+static const unsigned HW_EVENT_TYPE[HW_COUNTER_COUNT] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+    PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE, PERF_TYPE_SOFTWARE};
+
+static const unsigned long long HW_EVENT_CONFIG[HW_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,      PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,   PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_SW_PAGE_FAULTS_MIN, PERF_COUNT_SW_PAGE_FAULTS_MAJ};
+
+// Défauts de page du thread appelant depuis sa création
+static void ThreadFaults(long long faults[2]) {
+  struct rusage usage;
+  if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+    faults[0] = usage.ru_minflt;
+    faults[1] = usage.ru_majflt;
+  } else {
+    faults[0] = faults[1] = -1;
+  }
+}
+
+void HwCountersStart(HwCounterSession *session) {
+  for (int i = 0; i < HW_COUNTER_COUNT; i++)
+    session->fd[i] = -1;
+  session->faults[0] = session->faults[1] = -1;
+  if (!hw_enabled)
+    return;
+
+  for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+    if (hw_refused[i])
+      continue;
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = HW_EVENT_TYPE[i];
+    attr.config = HW_EVENT_CONFIG[i];
+    attr.disabled = 1;
+    attr.inherit = 1; // Threads créés par le tri (tri parallèle)
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    session->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    // Refus définitif (pas de PMU, droits): inutile de réessayer à chaque tri
+    if (session->fd[i] < 0 &&
+        (errno == ENOENT || errno == ENOSYS || errno == EACCES ||
+         errno == EPERM || errno == EOPNOTSUPP))
+      hw_refused[i] = 1;
+  }
+
+  if (session->fd[HW_MINOR_FAULTS] < 0 || session->fd[HW_MAJOR_FAULTS] < 0)
+    ThreadFaults(session->faults);
+
+  for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+    if (session->fd[i] >= 0) {
+      ioctl(session->fd[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(session->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+void HwCountersStop(HwCounterSession *session, HwCounterSample *out) {
+  for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+    if (session->fd[i] >= 0)
+      ioctl(session->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+  }
+
+  for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+    out->value[i] = HW_COUNTER_NA;
+    if (session->fd[i] < 0)
+      continue;
+    // valeur, temps activé, temps réellement compté
+    unsigned long long data[3];
+    if (read(session->fd[i], data, sizeof(data)) == (ssize_t)sizeof(data) &&
+        data[2] > 0) {
+      out->value[i] = (data[2] == data[1])
+                          ? (long long)data[0]
+                          : (long long)((double)data[0] * data[1] / data[2]);
+    }
+    close(session->fd[i]);
+    session->fd[i] = -1;
+  }
+
+  // Repli: threads auxiliaires du tri parallèle non comptés
+  if (session->faults[0] >= 0) {
+    long long now[2];
+    ThreadFaults(now);
+    for (int k = 0; k < 2; k++) {
+      if (out->value[HW_MINOR_FAULTS + k] == HW_COUNTER_NA && now[k] >= 0)
+        out->value[HW_MINOR_FAULTS + k] = now[k] - session->faults[k];
+    }
+  }
+}
+#else
+void HwCountersStart(HwCounterSession *session) {
+  for (int i = 0; i < HW_COUNTER_COUNT; i++)
+    session->fd[i] = -1;
+}
+
+void HwCountersStop(HwCounterSession *session, HwCounterSample *out) {
+  HwCountersClear(out);
+}
+#endif
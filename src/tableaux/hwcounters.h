@@ -0,0 +1,61 @@
+/**
+ * HWCOUNTERS.H - Compteurs matériels autour d'un tri
+ *
+ * Linux: perf_event_open, en espace utilisateur, pour le thread appelant et
+ * les threads qu'il crée pendant la mesure (tri parallèle). Ailleurs, ou si
+ * le noyau refuse (perf_event_paranoid, machine virtuelle, conteneur), les
+ * valeurs valent HW_COUNTER_NA.
+ *
+ * Les défauts de page sont des compteurs logiciels du noyau, souvent permis
+ * quand la PMU ne l'est pas. À défaut, getrusage les donne pour le seul
+ * thread appelant.
+ */
+
+#ifndef HWCOUNTERS_H
+#define HWCOUNTERS_H
+
+#include <stdbool.h>
+
+typedef enum {
+  HW_CYCLES,
+  HW_INSTRUCTIONS,
+  HW_BRANCH_MISSES,
+  HW_CACHE_MISSES, // Défauts du dernier niveau de cache
+  HW_MINOR_FAULTS, // Défauts de page sans E/S (première écriture)
+  HW_MAJOR_FAULTS, // Défauts de page lus sur disque (jeu projeté)
+  HW_COUNTER_COUNT
+} HwCounter;
+
+// Valeur d'un compteur indisponible
+#define HW_COUNTER_NA (-1LL)
+
+// Clés des compteurs (exports CSV/JSON), dans l'ordre de HwCounter
+extern const char *HW_COUNTER_KEYS[HW_COUNTER_COUNT];
+
+typedef struct {
+  long long value[HW_COUNTER_COUNT];
+} HwCounterSample;
+
+// Descripteurs ouverts entre HwCountersStart et HwCountersStop
+typedef struct {
+  int fd[HW_COUNTER_COUNT];
+  long long faults[2]; // getrusage au démarrage (repli), -1 si inutilisé
+} HwCounterSession;
+
+// Active ou non la capture (activée par défaut)
+void HwCountersEnable(bool enabled);
+
+// Ouvre et démarre les compteurs du thread appelant
+void HwCountersStart(HwCounterSession *session);
+
+// Arrête, lit (valeurs extrapolées si le noyau a multiplexé les compteurs)
+// et ferme les compteurs
+void HwCountersStop(HwCounterSession *session, HwCounterSample *out);
+
+// Met tous les compteurs à HW_COUNTER_NA
+void HwCountersClear(HwCounterSample *sample);
+
+// Instructions par cycle, 0 si indisponible
+double HwCountersIpc(const HwCounterSample *sample);
+
+#endif // HWCOUNTERS_H
@@ -0,0 +1,98 @@
+/**
+ * PAGEALLOC.C - Allocation des grands tableaux (pages énormes, premier accès)
+ */
+
+#ifndef _WIN32
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS, madvise
+#endif
+
+#include "pagealloc.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+// Taille d'une page énorme (x86-64, ARM64 en pages de 4 Ko)
+#define PAGE_HUGE_SIZE ((size_t)2 << 20)
+
+// Plus petite page: pas du préremplissage manuel
+#define PAGE_SMALL_SIZE 4096
+
+static volatile int huge_enabled = 1;
+static volatile int prefault_enabled = 0;
+
+void PageAllocEnableHugePages(bool enabled) { huge_enabled = enabled; }
+
+void PageAllocEnablePrefault(bool enabled) { prefault_enabled = enabled; }
+
+#ifdef _WIN32
+// Pages réservées et engagées, mais attribuées au premier accès. Les grandes
+// pages de Windows exigent un privilège (SeLockMemoryPrivilege): ignorées.
+void *PageAlloc(size_t bytes) {
+  if (bytes < PAGE_ALLOC_MIN)
+    return malloc(bytes > 0 ? bytes : 1);
+  return VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void PageFree(void *ptr, size_t bytes) {
+  if (!ptr)
+    return;
+  if (bytes < PAGE_ALLOC_MIN)
+    free(ptr);
+  else
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+#else
+void *PageAlloc(size_t bytes) {
+  if (bytes < PAGE_ALLOC_MIN)
+    return malloc(bytes > 0 ? bytes : 1);
+
+  // Marge de 2 Mo pour aligner le début: une page énorme ne couvre qu'une
+  // plage alignée, le reste du tableau tomberait en petites pages
+  size_t span = bytes + PAGE_HUGE_SIZE;
+  char *raw = (char *)mmap(NULL, span, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED)
+    return NULL;
+  char *ptr = (char *)(((uintptr_t)raw + PAGE_HUGE_SIZE - 1) &
+                       ~(uintptr_t)(PAGE_HUGE_SIZE - 1));
+  size_t tail = (size_t)(ptr - raw) + bytes;
+  tail = (tail + PAGE_SMALL_SIZE - 1) & ~(size_t)(PAGE_SMALL_SIZE - 1);
+  if (ptr > raw)
+    munmap(raw, (size_t)(ptr - raw));
+  if (tail < span)
+    munmap(raw + tail, span - tail);
+
+#ifdef MADV_HUGEPAGE
+  if (huge_enabled)
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+  return ptr;
+}
+
+void PageFree(void *ptr, size_t bytes) {
+  if (!ptr)
+    return;
+  if (bytes < PAGE_ALLOC_MIN)
+    free(ptr);
+  else
+    munmap(ptr, bytes);
+}
+#endif
+
+void PagePrefault(void *ptr, size_t bytes) {
+  if (!prefault_enabled || !ptr || bytes < PAGE_ALLOC_MIN)
+    return;
+#ifdef MADV_POPULATE_WRITE
+  // Linux 5.14+: toutes les pages en un appel, sans les lire
+  if (madvise(ptr, bytes, MADV_POPULATE_WRITE) == 0)
+    return;
+#endif
+  volatile char *p = (volatile char *)ptr;
+  for (size_t i = 0; i < bytes; i += PAGE_SMALL_SIZE)
+    p[i] = p[i];
+}
@@ -0,0 +1,41 @@
+/**
+ * PAGEALLOC.H - Allocation des grands tableaux de données
+ *
+ * Les tableaux de GenericData et les tampons des tris dépassent vite la
+ * mémoire couverte par le TLB. À partir de PAGE_ALLOC_MIN octets, ils sont
+ * projetés directement (mmap, VirtualAlloc), alignés sur 2 Mo et, sous Linux,
+ * marqués MADV_HUGEPAGE pour obtenir des pages énormes transparentes.
+ *
+ * Rien n'est touché à l'allocation: une page est placée sur le nœud NUMA du
+ * premier thread qui l'écrit. Un tampon doit donc être rempli (ou prérempli
+ * avec PagePrefault) par le thread qui va le trier.
+ */
+
+#ifndef PAGEALLOC_H
+#define PAGEALLOC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// En dessous, malloc: la projection ne gagnerait rien
+#define PAGE_ALLOC_MIN ((size_t)2 << 20)
+
+// Conseil MADV_HUGEPAGE (activé par défaut)
+void PageAllocEnableHugePages(bool enabled);
+
+// Préremplissage par PagePrefault (désactivé par défaut)
+void PageAllocEnablePrefault(bool enabled);
+
+// Tableau de bytes octets non initialisé, NULL si la mémoire manque
+void *PageAlloc(size_t bytes);
+
+// Libère un tableau de PageAlloc; bytes est la taille demandée à
+// l'allocation (elle choisit entre free et munmap)
+void PageFree(void *ptr, size_t bytes);
+
+// Fait les défauts de page d'un tableau de PageAlloc depuis le thread
+// appelant, en une fois, avant qu'il ne soit rempli. Contenu préservé. Sans
+// effet si le préremplissage est désactivé.
+void PagePrefault(void *ptr, size_t bytes);
+
+#endif // PAGEALLOC_H
@@ -0,0 +1,1101 @@
+/**
+ * SORT_TEMPLATE.H - Noyaux de tri génériques, instanciés par type
+ *
+ * Ce fichier n'a pas de garde d'inclusion: il est inclus une fois par type
+ * d'élément dans sorting.c, après avoir défini:
+ *   SORT_SUFFIX     suffixe des noms générés (Int -> BubbleSortInt, ...)
+ *   SORT_T          type d'un élément (substitué textuellement: une seule
+ *                   variable par déclaration, "SORT_T const *" pour const)
+ *   SORT_LESS(a, b) ordre strict entre deux éléments
+ *   SORT_FIELD      (optionnel) membre de GenericData.data: génère aussi les
+ *                   points d'entrée RunXxx utilisés par la table de dispatch
+ *   SORT_SMALL_SORT (optionnel) tri des feuilles de QuickSort d'au plus
+ *                   SMALL_SORT_MAX éléments: f(SORT_T *arr, size_t n)
+ *   SORT_SORTED_PREFIX (optionnel) préfixe déjà vérifié trié (SIMD):
+ *                   size_t f(SORT_T const *arr, size_t n)
+ *   SORT_EXTERNAL   (optionnel) génère aussi le tri externe (fichiers
+ *                   temporaires), pour les types de taille fixe
+ *   SORT_HASH(x)    (requis avec SORT_FIELD) empreinte 64 bits d'un élément,
+ *                   sommée par la vérification (VerifyRange)
+ * Les paramètres sont retirés (#undef) à la fin du fichier.
+ *
+ * Exemple:
+ *   #define SORT_SUFFIX Int
+ *   #define SORT_T long long
+ *   #define SORT_LESS(a, b) ((a) < (b))
+ *   #define SORT_FIELD int_data
+ *   #include "sort_template.h"
+ */
+
+#define SORT_CAT_(a, b) a##b
+#define SORT_CAT(a, b) SORT_CAT_(a, b)
+#define SORT_NAME(name) SORT_CAT(name, SORT_SUFFIX)
+
+void SORT_NAME(BubbleSort)(SORT_T *arr, size_t n) {
+  for (size_t i = 0; i + 1 < n; i++) {
+    long long swaps = 0;
+    for (size_t j = 0; j < n - i - 1; j++) {
+      if (SORT_LESS(arr[j + 1], arr[j])) {
+        SORT_T temp = arr[j];
+        arr[j] = arr[j + 1];
+        arr[j + 1] = temp;
+        swaps++;
+      }
+    }
+    if (SortTick(n - i - 1, swaps, 1) || swaps == 0)
+      break;
+  }
+}
+
+void SORT_NAME(InsertionSort)(SORT_T *arr, size_t n) {
+  long long misses = 0, moves = 0;
+  for (size_t i = 1; i < n; i++) {
+    SORT_T key = arr[i];
+    ptrdiff_t j = (ptrdiff_t)i - 1;
+    while (j >= 0 && SORT_LESS(key, arr[j])) {
+      arr[j + 1] = arr[j];
+      j--;
+      moves++;
+    }
+    arr[j + 1] = key;
+    misses += (j >= 0);
+    if ((i & SORT_TICK_MASK) == 0) {
+      if (SortTick(misses + moves, moves, 0))
+        return;
+      misses = moves = 0;
+    }
+  }
+  SortTick(misses + moves, moves, 1);
+}
+
+void SORT_NAME(ShellSort)(SORT_T *arr, size_t n) {
+  for (size_t gap = n / 2; gap > 0; gap /= 2) {
+    long long misses = 0, moves = 0;
+    for (size_t i = gap; i < n; i++) {
+      SORT_T temp = arr[i];
+      size_t j = i;
+      while (j >= gap && SORT_LESS(temp, arr[j - gap])) {
+        arr[j] = arr[j - gap];
+        j -= gap;
+        moves++;
+      }
+      arr[j] = temp;
+      misses += (j >= gap);
+      if ((i & SORT_TICK_MASK) == 0) {
+        if (SortTick(misses + moves, moves, 0))
+          return;
+        misses = moves = 0;
+      }
+    }
+    if (SortTick(misses + moves, moves, 1))
+      return;
+  }
+}
+
+static ptrdiff_t SORT_NAME(Partition)(SORT_T *arr, ptrdiff_t low,
+                                      ptrdiff_t high) {
+  SORT_T pivot = arr[high];
+  ptrdiff_t i = low - 1;
+  for (ptrdiff_t j = low; j < high; j++) {
+    if (!SORT_LESS(pivot, arr[j])) {
+      i++;
+      SORT_T temp = arr[i];
+      arr[i] = arr[j];
+      arr[j] = temp;
+    }
+  }
+  SORT_T temp = arr[i + 1];
+  arr[i + 1] = arr[high];
+  arr[high] = temp;
+  SortTick(high - low, i - low + 2, 1);
+  return i + 1;
+}
+
+void SORT_NAME(QuickSort)(SORT_T *arr, ptrdiff_t low, ptrdiff_t high) {
+  // Récursion sur la plus petite partie, boucle sur la plus grande: pile
+  // en O(log n) même sur une entrée triée (pire cas du pivot = dernier)
+  while (low < high && !SortStopRequested()) {
+#ifdef SORT_SMALL_SORT
+    if (high - low < SMALL_SORT_MAX) {
+      SORT_SMALL_SORT(arr + low, (size_t)(high - low + 1));
+      return;
+    }
+#endif
+    ptrdiff_t pi = SORT_NAME(Partition)(arr, low, high);
+    if (pi - low < high - pi) {
+      SORT_NAME(QuickSort)(arr, low, pi - 1);
+      low = pi + 1;
+    } else {
+      SORT_NAME(QuickSort)(arr, pi + 1, high);
+      high = pi - 1;
+    }
+  }
+}
+
+// Introsort: quicksort (pivot médiane de 3 / ninther) + insertion sur les
+// petites plages + heapsort si la profondeur dépasse 2*log2(n)
+static void SORT_NAME(InsertionRange)(SORT_T *arr, ptrdiff_t lo,
+                                      ptrdiff_t hi) {
+  long long misses = 0, moves = 0;
+  for (ptrdiff_t i = lo + 1; i <= hi; i++) {
+    SORT_T key = arr[i];
+    ptrdiff_t j = i - 1;
+    while (j >= lo && SORT_LESS(key, arr[j])) {
+      arr[j + 1] = arr[j];
+      j--;
+      moves++;
+    }
+    arr[j + 1] = key;
+    misses += (j >= lo);
+  }
+  SortTick(misses + moves, moves, 0);
+}
+
+// Renvoie le nombre de comparaisons effectuées
+static int SORT_NAME(SiftDown)(SORT_T *arr, size_t lo, size_t root,
+                               size_t n) {
+  SORT_T value = arr[lo + root];
+  size_t child;
+  int comparisons = 0;
+  while ((child = 2 * root + 1) < n) {
+    if (child + 1 < n && SORT_LESS(arr[lo + child], arr[lo + child + 1]))
+      child++;
+    comparisons += 2;
+    if (!SORT_LESS(value, arr[lo + child]))
+      break;
+    arr[lo + root] = arr[lo + child];
+    root = child;
+  }
+  arr[lo + root] = value;
+  return comparisons;
+}
+
+static void SORT_NAME(HeapSortRange)(SORT_T *arr, size_t lo, size_t hi) {
+  size_t n = hi - lo + 1;
+  long long comparisons = 0;
+  for (size_t i = n / 2; i-- > 0;)
+    comparisons += SORT_NAME(SiftDown)(arr, lo, i, n);
+  for (size_t end = n - 1; end > 0; end--) {
+    SORT_T temp = arr[lo];
+    arr[lo] = arr[lo + end];
+    arr[lo + end] = temp;
+    comparisons += SORT_NAME(SiftDown)(arr, lo, 0, end);
+    if ((end & SORT_TICK_MASK) == 0) {
+      if (SortTick(comparisons, 0, 0))
+        return;
+      comparisons = 0;
+    }
+  }
+  SortTick(comparisons, (long long)n, 1);
+}
+
+static ptrdiff_t SORT_NAME(MedianOfThree)(SORT_T *arr, ptrdiff_t a,
+                                          ptrdiff_t b, ptrdiff_t c) {
+  if (SORT_LESS(arr[a], arr[b])) {
+    if (SORT_LESS(arr[b], arr[c]))
+      return b;
+    return SORT_LESS(arr[a], arr[c]) ? c : a;
+  }
+  if (SORT_LESS(arr[a], arr[c]))
+    return a;
+  return SORT_LESS(arr[b], arr[c]) ? c : b;
+}
+
+static void SORT_NAME(IntroLoop)(SORT_T *arr, ptrdiff_t lo, ptrdiff_t hi,
+                                 int depth) {
+  while (hi - lo + 1 > INTRO_INSERTION_CUTOFF) {
+    if (depth == 0) {
+      SORT_NAME(HeapSortRange)(arr, (size_t)lo, (size_t)hi);
+      return;
+    }
+    depth--;
+
+    ptrdiff_t n = hi - lo + 1;
+    ptrdiff_t mid = lo + n / 2;
+    ptrdiff_t p;
+    if (n > INTRO_NINTHER_THRESHOLD) {
+      ptrdiff_t s = n / 8;
+      ptrdiff_t m1 = SORT_NAME(MedianOfThree)(arr, lo, lo + s, lo + 2 * s);
+      ptrdiff_t m2 = SORT_NAME(MedianOfThree)(arr, mid - s, mid, mid + s);
+      ptrdiff_t m3 = SORT_NAME(MedianOfThree)(arr, hi - 2 * s, hi - s, hi);
+      p = SORT_NAME(MedianOfThree)(arr, m1, m2, m3);
+    } else {
+      p = SORT_NAME(MedianOfThree)(arr, lo, mid, hi);
+    }
+
+    // Partition de Hoare, pivot placé en tête
+    SORT_T temp = arr[p];
+    arr[p] = arr[lo];
+    arr[lo] = temp;
+    SORT_T pivot = arr[lo];
+    ptrdiff_t i = lo, j = hi + 1;
+    long long swaps = 0;
+    for (;;) {
+      do
+        i++;
+      while (i <= hi && SORT_LESS(arr[i], pivot));
+      do
+        j--;
+      while (SORT_LESS(pivot, arr[j]));
+      if (i >= j)
+        break;
+      temp = arr[i];
+      arr[i] = arr[j];
+      arr[j] = temp;
+      swaps++;
+    }
+    arr[lo] = arr[j];
+    arr[j] = pivot;
+
+    // Une partition de Hoare compare chaque élément environ une fois
+    if (SortTick(n, swaps + 1, 1))
+      return;
+
+    // Récursion sur la plus petite moitié, boucle sur la plus grande
+    if (j - lo < hi - j) {
+      SORT_NAME(IntroLoop)(arr, lo, j - 1, depth);
+      lo = j + 1;
+    } else {
+      SORT_NAME(IntroLoop)(arr, j + 1, hi, depth);
+      hi = j - 1;
+    }
+  }
+  SORT_NAME(InsertionRange)(arr, lo, hi);
+}
+
+void SORT_NAME(IntroSort)(SORT_T *arr, size_t n) {
+  if (n > 1)
+    SORT_NAME(IntroLoop)(arr, 0, (ptrdiff_t)n - 1, IntroDepthLimit(n));
+}
+
+// Tri fusion ascendant (stable): blocs de MERGE_RUN éléments triés par
+// insertion, puis passes de fusion de largeur doublée qui alternent entre
+// arr et un tampon unique alloué une fois. L'arrêt n'est pris en compte
+// qu'entre deux passes, pour que arr reste une permutation des données.
+static void SORT_NAME(MergeRuns)(SORT_T const *src, SORT_T *dst, size_t lo,
+                                 size_t mid, size_t hi) {
+  // Blocs déjà dans l'ordre: simple recopie
+  if (mid == hi || !SORT_LESS(src[mid], src[mid - 1])) {
+    memcpy(dst + lo, src + lo, (hi - lo) * sizeof(SORT_T));
+    SortTick(1, (long long)(hi - lo), 0);
+    return;
+  }
+  size_t i = lo, j = mid, k = lo;
+  while (i < mid && j < hi)
+    dst[k++] = SORT_LESS(src[j], src[i]) ? src[j++] : src[i++];
+  SortTick((long long)(k - lo), (long long)(hi - lo), 0);
+  while (i < mid)
+    dst[k++] = src[i++];
+  while (j < hi)
+    dst[k++] = src[j++];
+}
+
+void SORT_NAME(MergeSort)(SORT_T *arr, size_t n) {
+  if (n < 2)
+    return;
+  SORT_T *buffer = (SORT_T *)PageAlloc(n * sizeof(SORT_T));
+  if (!buffer) {
+    SortNote("memoire insuffisante: insertion");
+    SORT_NAME(InsertionSort)(arr, n);
+    return;
+  }
+
+  for (size_t lo = 0; lo < n; lo += MERGE_RUN) {
+    size_t hi = (n - lo > MERGE_RUN) ? lo + MERGE_RUN : n;
+    SORT_NAME(InsertionRange)(arr, (ptrdiff_t)lo, (ptrdiff_t)hi - 1);
+  }
+
+  SORT_T *src = arr;
+  SORT_T *dst = buffer;
+  for (size_t width = MERGE_RUN; width < n && !SortStopRequested();
+       width *= 2) {
+    for (size_t lo = 0; lo < n; lo += 2 * width) {
+      size_t mid = (n - lo > width) ? lo + width : n;
+      size_t hi = (n - mid > width) ? mid + width : n;
+      SORT_NAME(MergeRuns)(src, dst, lo, mid, hi);
+    }
+    SortTick(0, 0, 1);
+    SORT_T *temp = src;
+    src = dst;
+    dst = temp;
+  }
+
+  if (src != arr)
+    memcpy(arr, src, n * sizeof(SORT_T));
+  PageFree(buffer, n * sizeof(SORT_T));
+}
+
+// TimSort (stable): découpage en suites naturelles (les suites strictement
+// décroissantes sont retournées), allongées à minrun par insertion
+// dichotomique, empilées puis fusionnées selon les invariants de pile;
+// les fusions passent en mode galop quand un côté gagne TIM_MIN_GALLOP
+// fois de suite. Tampon de n/2 éléments alloué une fois.
+typedef struct {
+  SORT_T *arr;
+  SORT_T *tmp;
+  int min_gallop;
+  int runs;
+  ptrdiff_t run_base[TIM_MAX_RUNS];
+  ptrdiff_t run_len[TIM_MAX_RUNS];
+} SORT_NAME(TimState);
+
+// Longueur de la suite commençant en lo (rendue croissante)
+static size_t SORT_NAME(TimCountRun)(SORT_T *arr, size_t lo, size_t hi) {
+  size_t run_hi = lo + 1;
+  if (run_hi == hi)
+    return 1;
+  if (SORT_LESS(arr[run_hi++], arr[lo])) {
+    // Strictement décroissante: retournée sans casser la stabilité
+    while (run_hi < hi && SORT_LESS(arr[run_hi], arr[run_hi - 1]))
+      run_hi++;
+    for (size_t i = lo, j = run_hi - 1; i < j; i++, j--) {
+      SORT_T temp = arr[i];
+      arr[i] = arr[j];
+      arr[j] = temp;
+    }
+  } else {
+    while (run_hi < hi && !SORT_LESS(arr[run_hi], arr[run_hi - 1]))
+      run_hi++;
+  }
+  SortTick((long long)(run_hi - lo), 0, 0);
+  return run_hi - lo;
+}
+
+// Insertion dichotomique de [start, hi) dans [lo, start) déjà trié
+static void SORT_NAME(TimBinaryInsertion)(SORT_T *arr, size_t lo, size_t hi,
+                                          size_t start) {
+  long long comparisons = 0, moves = 0;
+  for (; start < hi; start++) {
+    SORT_T pivot = arr[start];
+    size_t left = lo, right = start;
+    while (left < right) {
+      size_t mid = left + (right - left) / 2;
+      if (SORT_LESS(pivot, arr[mid]))
+        right = mid;
+      else
+        left = mid + 1;
+      comparisons++;
+    }
+    memmove(arr + left + 1, arr + left, (start - left) * sizeof(SORT_T));
+    arr[left] = pivot;
+    moves += (long long)(start - left + 1);
+  }
+  SortTick(comparisons, moves, 0);
+}
+
+// Position d'insertion de key la plus à gauche dans a[0, len): recherche
+// exponentielle depuis hint puis dichotomique
+static ptrdiff_t SORT_NAME(GallopLeft)(SORT_T key, SORT_T const *a,
+                                       ptrdiff_t len, ptrdiff_t hint) {
+  ptrdiff_t last_ofs = 0, ofs = 1;
+  if (SORT_LESS(a[hint], key)) {
+    ptrdiff_t max_ofs = len - hint;
+    while (ofs < max_ofs && SORT_LESS(a[hint + ofs], key)) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0)
+        ofs = max_ofs;
+    }
+    if (ofs > max_ofs)
+      ofs = max_ofs;
+    last_ofs += hint;
+    ofs += hint;
+  } else {
+    ptrdiff_t max_ofs = hint + 1;
+    while (ofs < max_ofs && !SORT_LESS(a[hint - ofs], key)) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0)
+        ofs = max_ofs;
+    }
+    if (ofs > max_ofs)
+      ofs = max_ofs;
+    ptrdiff_t temp = last_ofs;
+    last_ofs = hint - ofs;
+    ofs = hint - temp;
+  }
+  last_ofs++;
+  while (last_ofs < ofs) {
+    ptrdiff_t m = last_ofs + (ofs - last_ofs) / 2;
+    if (SORT_LESS(a[m], key))
+      last_ofs = m + 1;
+    else
+      ofs = m;
+  }
+  return ofs;
+}
+
+// Position d'insertion de key la plus à droite dans a[0, len)
+static ptrdiff_t SORT_NAME(GallopRight)(SORT_T key, SORT_T const *a,
+                                        ptrdiff_t len, ptrdiff_t hint) {
+  ptrdiff_t last_ofs = 0, ofs = 1;
+  if (SORT_LESS(key, a[hint])) {
+    ptrdiff_t max_ofs = hint + 1;
+    while (ofs < max_ofs && SORT_LESS(key, a[hint - ofs])) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0)
+        ofs = max_ofs;
+    }
+    if (ofs > max_ofs)
+      ofs = max_ofs;
+    ptrdiff_t temp = last_ofs;
+    last_ofs = hint - ofs;
+    ofs = hint - temp;
+  } else {
+    ptrdiff_t max_ofs = len - hint;
+    while (ofs < max_ofs && !SORT_LESS(key, a[hint + ofs])) {
+      last_ofs = ofs;
+      ofs = (ofs << 1) + 1;
+      if (ofs <= 0)
+        ofs = max_ofs;
+    }
+    if (ofs > max_ofs)
+      ofs = max_ofs;
+    last_ofs += hint;
+    ofs += hint;
+  }
+  last_ofs++;
+  while (last_ofs < ofs) {
+    ptrdiff_t m = last_ofs + (ofs - last_ofs) / 2;
+    if (SORT_LESS(key, a[m]))
+      ofs = m;
+    else
+      last_ofs = m + 1;
+  }
+  return ofs;
+}
+
+// Fusion de deux suites voisines, la première (len1 <= len2) copiée dans
+// tmp. Précondition: a[base2] < a[base1] et le dernier élément de la
+// première suite est supérieur à toute la seconde.
+static void SORT_NAME(TimMergeLo)(SORT_NAME(TimState) * s, ptrdiff_t base1,
+                                  ptrdiff_t len1, ptrdiff_t base2,
+                                  ptrdiff_t len2) {
+  SORT_T *arr = s->arr;
+  SORT_T *tmp = s->tmp;
+  memcpy(tmp, arr + base1, (size_t)len1 * sizeof(SORT_T));
+  ptrdiff_t c1 = 0, c2 = base2, dest = base1;
+
+  arr[dest++] = arr[c2++];
+  if (--len2 == 0) {
+    memcpy(arr + dest, tmp, (size_t)len1 * sizeof(SORT_T));
+    return;
+  }
+  if (len1 == 1) {
+    memmove(arr + dest, arr + c2, (size_t)len2 * sizeof(SORT_T));
+    arr[dest + len2] = tmp[c1];
+    return;
+  }
+
+  int min_gallop = s->min_gallop;
+  bool done = false;
+  while (!done) {
+    ptrdiff_t count1 = 0, count2 = 0;
+    // Un élément à la fois tant qu'aucun côté ne domine
+    while ((count1 | count2) < min_gallop) {
+      if (SORT_LESS(arr[c2], tmp[c1])) {
+        arr[dest++] = arr[c2++];
+        count2++;
+        count1 = 0;
+        if (--len2 == 0) {
+          done = true;
+          break;
+        }
+      } else {
+        arr[dest++] = tmp[c1++];
+        count1++;
+        count2 = 0;
+        if (--len1 == 1) {
+          done = true;
+          break;
+        }
+      }
+    }
+    // Mode galop: copie de séries entières trouvées par recherche
+    while (!done) {
+      count1 = SORT_NAME(GallopRight)(arr[c2], tmp + c1, len1, 0);
+      if (count1 != 0) {
+        memcpy(arr + dest, tmp + c1, (size_t)count1 * sizeof(SORT_T));
+        dest += count1;
+        c1 += count1;
+        len1 -= count1;
+        if (len1 <= 1) {
+          done = true;
+          break;
+        }
+      }
+      arr[dest++] = arr[c2++];
+      if (--len2 == 0) {
+        done = true;
+        break;
+      }
+      count2 = SORT_NAME(GallopLeft)(tmp[c1], arr + c2, len2, 0);
+      if (count2 != 0) {
+        memmove(arr + dest, arr + c2, (size_t)count2 * sizeof(SORT_T));
+        dest += count2;
+        c2 += count2;
+        len2 -= count2;
+        if (len2 == 0) {
+          done = true;
+          break;
+        }
+      }
+      arr[dest++] = tmp[c1++];
+      if (--len1 == 1) {
+        done = true;
+        break;
+      }
+      min_gallop--;
+      if (count1 < TIM_MIN_GALLOP && count2 < TIM_MIN_GALLOP)
+        break;
+    }
+    if (!done) {
+      // Sortie du galop: il devient plus difficile d'y revenir
+      if (min_gallop < 0)
+        min_gallop = 0;
+      min_gallop += 2;
+    }
+  }
+  s->min_gallop = (min_gallop < 1) ? 1 : min_gallop;
+
+  if (len1 == 1) {
+    memmove(arr + dest, arr + c2, (size_t)len2 * sizeof(SORT_T));
+    arr[dest + len2] = tmp[c1];
+  } else if (len1 > 0) {
+    memcpy(arr + dest, tmp + c1, (size_t)len1 * sizeof(SORT_T));
+  }
+}
+
+// Symétrique de TimMergeLo (len1 > len2): la seconde suite est copiée dans
+// tmp et la fusion se fait de droite à gauche
+static void SORT_NAME(TimMergeHi)(SORT_NAME(TimState) * s, ptrdiff_t base1,
+                                  ptrdiff_t len1, ptrdiff_t base2,
+                                  ptrdiff_t len2) {
+  SORT_T *arr = s->arr;
+  SORT_T *tmp = s->tmp;
+  memcpy(tmp, arr + base2, (size_t)len2 * sizeof(SORT_T));
+  ptrdiff_t c1 = base1 + len1 - 1, c2 = len2 - 1, dest = base2 + len2 - 1;
+
+  arr[dest--] = arr[c1--];
+  if (--len1 == 0) {
+    memcpy(arr + dest - (len2 - 1), tmp, (size_t)len2 * sizeof(SORT_T));
+    return;
+  }
+  if (len2 == 1) {
+    dest -= len1;
+    c1 -= len1;
+    memmove(arr + dest + 1, arr + c1 + 1, (size_t)len1 * sizeof(SORT_T));
+    arr[dest] = tmp[c2];
+    return;
+  }
+
+  int min_gallop = s->min_gallop;
+  bool done = false;
+  while (!done) {
+    ptrdiff_t count1 = 0, count2 = 0;
+    while ((count1 | count2) < min_gallop) {
+      if (SORT_LESS(tmp[c2], arr[c1])) {
+        arr[dest--] = arr[c1--];
+        count1++;
+        count2 = 0;
+        if (--len1 == 0) {
+          done = true;
+          break;
+        }
+      } else {
+        arr[dest--] = tmp[c2--];
+        count2++;
+        count1 = 0;
+        if (--len2 == 1) {
+          done = true;
+          break;
+        }
+      }
+    }
+    while (!done) {
+      count1 = len1 - SORT_NAME(GallopRight)(tmp[c2], arr + base1, len1,
+                                             len1 - 1);
+      if (count1 != 0) {
+        dest -= count1;
+        c1 -= count1;
+        len1 -= count1;
+        memmove(arr + dest + 1, arr + c1 + 1,
+                (size_t)count1 * sizeof(SORT_T));
+        if (len1 == 0) {
+          done = true;
+          break;
+        }
+      }
+      arr[dest--] = tmp[c2--];
+      if (--len2 == 1) {
+        done = true;
+        break;
+      }
+      count2 = len2 - SORT_NAME(GallopLeft)(arr[c1], tmp, len2, len2 - 1);
+      if (count2 != 0) {
+        dest -= count2;
+        c2 -= count2;
+        len2 -= count2;
+        memcpy(arr + dest + 1, tmp + c2 + 1, (size_t)count2 * sizeof(SORT_T));
+        if (len2 <= 1) {
+          done = true;
+          break;
+        }
+      }
+      arr[dest--] = arr[c1--];
+      if (--len1 == 0) {
+        done = true;
+        break;
+      }
+      min_gallop--;
+      if (count1 < TIM_MIN_GALLOP && count2 < TIM_MIN_GALLOP)
+        break;
+    }
+    if (!done) {
+      if (min_gallop < 0)
+        min_gallop = 0;
+      min_gallop += 2;
+    }
+  }
+  s->min_gallop = (min_gallop < 1) ? 1 : min_gallop;
+
+  if (len2 == 1) {
+    dest -= len1;
+    c1 -= len1;
+    memmove(arr + dest + 1, arr + c1 + 1, (size_t)len1 * sizeof(SORT_T));
+    arr[dest] = tmp[c2];
+  } else if (len2 > 0) {
+    memcpy(arr + dest - (len2 - 1), tmp, (size_t)len2 * sizeof(SORT_T));
+  }
+}
+
+// Fusionne les suites i et i + 1 de la pile
+static void SORT_NAME(TimMergeAt)(SORT_NAME(TimState) * s, int i) {
+  SORT_T *arr = s->arr;
+  ptrdiff_t base1 = s->run_base[i], len1 = s->run_len[i];
+  ptrdiff_t base2 = s->run_base[i + 1], len2 = s->run_len[i + 1];
+
+  s->run_len[i] = len1 + len2;
+  if (i == s->runs - 3) {
+    s->run_base[i + 1] = s->run_base[i + 2];
+    s->run_len[i + 1] = s->run_len[i + 2];
+  }
+  s->runs--;
+  SortTick(len1 + len2, len1 + len2, 1);
+
+  // Les éléments déjà à leur place aux deux extrémités ne bougent pas
+  ptrdiff_t k = SORT_NAME(GallopRight)(arr[base2], arr + base1, len1, 0);
+  base1 += k;
+  len1 -= k;
+  if (len1 == 0)
+    return;
+  len2 = SORT_NAME(GallopLeft)(arr[base1 + len1 - 1], arr + base2, len2,
+                               len2 - 1);
+  if (len2 == 0)
+    return;
+
+  if (len1 <= len2)
+    SORT_NAME(TimMergeLo)(s, base1, len1, base2, len2);
+  else
+    SORT_NAME(TimMergeHi)(s, base1, len1, base2, len2);
+}
+
+// Rétablit les invariants de pile (version corrigée de 2015):
+// len[i-2] > len[i-1] + len[i] et len[i-1] > len[i]
+static void SORT_NAME(TimMergeCollapse)(SORT_NAME(TimState) * s) {
+  ptrdiff_t *len = s->run_len;
+  while (s->runs > 1) {
+    int n = s->runs - 2;
+    if ((n > 0 && len[n - 1] <= len[n] + len[n + 1]) ||
+        (n > 1 && len[n - 2] <= len[n] + len[n - 1])) {
+      if (len[n - 1] < len[n + 1])
+        n--;
+    } else if (len[n] > len[n + 1]) {
+      break;
+    }
+    SORT_NAME(TimMergeAt)(s, n);
+  }
+}
+
+void SORT_NAME(TimSort)(SORT_T *arr, size_t n) {
+  if (n < 2)
+    return;
+  if (n < TIM_MIN_MERGE) {
+    size_t run = SORT_NAME(TimCountRun)(arr, 0, n);
+    SORT_NAME(TimBinaryInsertion)(arr, 0, n, run);
+    return;
+  }
+
+  SORT_NAME(TimState) s;
+  s.arr = arr;
+  s.tmp = (SORT_T *)PageAlloc((n / 2 + 1) * sizeof(SORT_T));
+  if (!s.tmp) {
+    SortNote("memoire insuffisante: insertion");
+    SORT_NAME(InsertionSort)(arr, n);
+    return;
+  }
+  s.min_gallop = TIM_MIN_GALLOP;
+  s.runs = 0;
+
+  size_t min_run = TimMinRun(n);
+  size_t lo = 0, natural = 0;
+  while (lo < n && !SortStopRequested()) {
+    size_t run = SORT_NAME(TimCountRun)(arr, lo, n);
+    if (run < min_run) {
+      size_t force = (n - lo <= min_run) ? n - lo : min_run;
+      SORT_NAME(TimBinaryInsertion)(arr, lo, lo + force, lo + run);
+      run = force;
+    } else {
+      natural++;
+    }
+    s.run_base[s.runs] = (ptrdiff_t)lo;
+    s.run_len[s.runs] = (ptrdiff_t)run;
+    s.runs++;
+    SORT_NAME(TimMergeCollapse)(&s);
+    lo += run;
+  }
+
+  // Fusion des suites restantes (toujours menée à terme: permutation)
+  while (s.runs > 1) {
+    int i = s.runs - 2;
+    if (i > 0 && s.run_len[i - 1] < s.run_len[i + 1])
+      i--;
+    SORT_NAME(TimMergeAt)(&s, i);
+  }
+  PageFree(s.tmp, (n / 2 + 1) * sizeof(SORT_T));
+  if (natural > 0)
+    SortNote("%zu suite(s) naturelle(s)", natural);
+}
+
+#ifdef SORT_EXTERNAL
+// Tri externe: suites de ExternalRunLength() éléments triées en mémoire
+// (introsort) et écrites chacune dans un fichier temporaire, puis fusion
+// à k voies par un tas des têtes de suites, relues par grands blocs. Le
+// budget mémoire (SetExternalMemory) borne la taille des suites et des
+// tampons de lecture; la sortie est réécrite dans arr.
+typedef struct {
+  FILE *file;
+  SORT_T *block;  // Tampon de lecture
+  int pos;        // Prochain élément du bloc
+  int count;      // Éléments valides du bloc
+  long long len;  // Éléments de la suite
+  long long left; // Éléments restant dans le fichier
+} SORT_NAME(ExternalRun);
+
+// Recharge le bloc d'une suite; false si elle est épuisée. Une lecture
+// courte est reprise à sa position exacte; si elle échoue encore, la suite
+// est déclarée illisible (*failed) et abandonnée.
+static bool SORT_NAME(ExternalRefill)(SORT_NAME(ExternalRun) * run,
+                                      int block_len, bool *failed) {
+  if (run->left <= 0)
+    return false;
+  int want = (run->left < block_len) ? (int)run->left : block_len;
+  int got = (int)fread(run->block, sizeof(SORT_T), (size_t)want, run->file);
+  if (got < want) {
+    long long done = run->len - run->left + got;
+    clearerr(run->file);
+    if (done <= LONG_MAX / (long long)sizeof(SORT_T) &&
+        fseek(run->file, (long)(done * (long long)sizeof(SORT_T)),
+              SEEK_SET) == 0)
+      got += (int)fread(run->block + got, sizeof(SORT_T),
+                        (size_t)(want - got), run->file);
+  }
+  run->pos = 0;
+  run->count = got;
+  if (got < want) {
+    *failed = true;
+    run->left = 0;
+  } else {
+    run->left -= got;
+  }
+  return got > 0;
+}
+
+// Ordre du tas: tête la plus petite, puis suite la plus à gauche
+static inline bool SORT_NAME(ExternalBefore)(SORT_NAME(ExternalRun) * runs,
+                                             size_t a, size_t b) {
+  SORT_T va = runs[a].block[runs[a].pos];
+  SORT_T vb = runs[b].block[runs[b].pos];
+  return SORT_LESS(va, vb) || (!SORT_LESS(vb, va) && a < b);
+}
+
+// Renvoie le nombre de comparaisons effectuées
+static int SORT_NAME(ExternalSift)(SORT_NAME(ExternalRun) * runs,
+                                   size_t *heap, size_t size, size_t root) {
+  size_t value = heap[root], child;
+  int comparisons = 0;
+  while ((child = 2 * root + 1) < size) {
+    if (child + 1 < size &&
+        SORT_NAME(ExternalBefore)(runs, heap[child + 1], heap[child]))
+      child++;
+    comparisons += 2;
+    if (!SORT_NAME(ExternalBefore)(runs, heap[child], value))
+      break;
+    heap[root] = heap[child];
+    root = child;
+  }
+  heap[root] = value;
+  return comparisons;
+}
+
+// Chaque fichier doit contenir sa suite entière avant que la fusion ne
+// commence à écraser arr: une suite tronquée est détectée quand arr est
+// encore une permutation (les suites triées sur place)
+static bool SORT_NAME(ExternalComplete)(SORT_NAME(ExternalRun) * runs,
+                                        size_t run_count) {
+  for (size_t r = 0; r < run_count; r++) {
+    if (fseek(runs[r].file, 0, SEEK_END) != 0)
+      return false;
+    long long bytes = ftell(runs[r].file);
+    if (bytes != runs[r].len * (long long)sizeof(SORT_T))
+      return false;
+  }
+  return true;
+}
+
+// Fusion à k voies des suites relues depuis le disque. Sur demande
+// d'arrêt, le reste des suites est recopié tel quel pour que arr reste
+// une permutation. Renvoie le nombre d'éléments écrits (moins de n si une
+// suite est devenue illisible, *failed est alors levé).
+static size_t SORT_NAME(ExternalMerge)(SORT_T *arr,
+                                       SORT_NAME(ExternalRun) * runs,
+                                       size_t run_count, size_t *heap,
+                                       int block_len, bool *failed) {
+  size_t size = 0;
+  for (size_t r = 0; r < run_count; r++) {
+    rewind(runs[r].file);
+    if (SORT_NAME(ExternalRefill)(&runs[r], block_len, failed))
+      heap[size++] = r;
+  }
+  for (size_t i = size / 2; i-- > 0;)
+    SORT_NAME(ExternalSift)(runs, heap, size, i);
+
+  size_t out = 0;
+  long long comparisons = 0;
+  while (size > 0) {
+    SORT_NAME(ExternalRun) *run = &runs[heap[0]];
+    arr[out++] = run->block[run->pos++];
+    if (run->pos == run->count &&
+        !SORT_NAME(ExternalRefill)(run, block_len, failed))
+      heap[0] = heap[--size];
+    comparisons += SORT_NAME(ExternalSift)(runs, heap, size, 0);
+
+    if ((out & SORT_TICK_MASK) == 0) {
+      if (SortTick(comparisons, SORT_TICK_MASK + 1, 0))
+        break;
+      comparisons = 0;
+    }
+  }
+
+  // Arrêt: vidage des suites restantes, sans fusion
+  for (size_t i = 0; i < size; i++) {
+    SORT_NAME(ExternalRun) *run = &runs[heap[i]];
+    do {
+      int len = run->count - run->pos;
+      memcpy(arr + out, run->block + run->pos, (size_t)len * sizeof(SORT_T));
+      out += len;
+    } while (SORT_NAME(ExternalRefill)(run, block_len, failed));
+  }
+  return out;
+}
+
+void SORT_NAME(ExternalSort)(SORT_T *arr, size_t n) {
+  if (n < 2)
+    return;
+  size_t run_len = (size_t)ExternalRunLength(sizeof(SORT_T));
+  if (n <= run_len) {
+    SortNote("1 suite: tri en memoire");
+    SORT_NAME(IntroSort)(arr, n);
+    return;
+  }
+
+  // Un petit budget (-m) et un grand n donnent beaucoup de suites: size_t
+  size_t run_count = (n - 1) / run_len + 1;
+  int block_len = ExternalBlockLength(sizeof(SORT_T), run_count);
+  SORT_NAME(ExternalRun) *runs = (SORT_NAME(ExternalRun) *)calloc(
+      run_count, sizeof(SORT_NAME(ExternalRun)));
+  size_t *heap = (size_t *)malloc(run_count * sizeof(size_t));
+  SORT_T *blocks = NULL;
+  if (run_count <= SIZE_MAX / sizeof(SORT_T) / (size_t)block_len)
+    blocks = (SORT_T *)malloc(run_count * block_len * sizeof(SORT_T));
+  bool ok = runs && heap && blocks;
+
+  // Phase 1: chaque suite est triée sur place puis écrite sur disque.
+  // Les E/S se font par blocs entiers: pas de tampon stdio (double copie).
+  size_t written = 0;
+  for (size_t r = 0; ok && r < run_count && !SortStopRequested(); r++) {
+    size_t lo = r * run_len;
+    size_t len = (n - lo < run_len) ? n - lo : run_len;
+    SORT_NAME(IntroSort)(arr + lo, len);
+
+    runs[r].file = tmpfile();
+    runs[r].block = blocks + r * block_len;
+    runs[r].len = (long long)len;
+    runs[r].left = (long long)len;
+    ok = runs[r].file != NULL &&
+         setvbuf(runs[r].file, NULL, _IONBF, 0) == 0 &&
+         fwrite(arr + lo, sizeof(SORT_T), len, runs[r].file) == len;
+    SortTick(0, (long long)len, 1);
+    written += ok;
+  }
+  if (ok && written == run_count)
+    ok = SORT_NAME(ExternalComplete)(runs, run_count);
+
+  if (!ok) {
+    // Fichiers temporaires indisponibles: arr est intact, tri en mémoire
+    SortNote("E/S impossible: introsort");
+    SORT_NAME(IntroSort)(arr, n);
+  } else if (written == run_count) {
+    // Phase 2: fusion à k voies
+    bool failed = false;
+    size_t out = SORT_NAME(ExternalMerge)(arr, runs, run_count, heap,
+                                          block_len, &failed);
+    SortTick(0, 0, 1);
+    if (failed || out != n) {
+      // Les éléments illisibles n'existaient plus que sur disque: arr
+      // n'est pas récupérable, l'échec est signalé (la vérification le
+      // confirmera) au lieu d'être présenté comme un tri
+      SortNote("ECHEC: lecture disque (%zu/%zu)", out, n);
+    } else if (!SortStopRequested()) {
+      SortNote("%zu suites sur disque", run_count);
+    }
+  }
+
+  for (size_t r = 0; runs && r < run_count; r++) {
+    if (runs[r].file)
+      fclose(runs[r].file);
+  }
+  free(blocks);
+  free(heap);
+  free(runs);
+}
+#endif
+
+// Fusion parallèle: nombre d'éléments de a parmi les k premiers de la
+// fusion stable de a et b (co-rang, recherche dichotomique)
+static inline size_t SORT_NAME(CoRank)(size_t k, SORT_T const *a, size_t na,
+                                       SORT_T const *b, size_t nb) {
+  size_t lo = (k > nb) ? k - nb : 0;
+  size_t hi = (k < na) ? k : na;
+  while (lo < hi) {
+    size_t i = lo + (hi - lo) / 2;
+    if (!SORT_LESS(b[k - i - 1], a[i]))
+      lo = i + 1;
+    else
+      hi = i;
+  }
+  return lo;
+}
+
+// Écrit les éléments [k_begin, k_end) de la fusion de a et b dans out
+static inline void SORT_NAME(MergeRange)(SORT_T const *a, size_t na,
+                                         SORT_T const *b, size_t nb,
+                                         size_t k_begin, size_t k_end,
+                                         SORT_T *out) {
+  size_t i = SORT_NAME(CoRank)(k_begin, a, na, b, nb);
+  size_t j = k_begin - i;
+  for (size_t k = k_begin; k < k_end; k++) {
+    if (j >= nb || (i < na && !SORT_LESS(b[j], a[i])))
+      out[k] = a[i++];
+    else
+      out[k] = b[j++];
+  }
+}
+
+static inline bool SORT_NAME(IsSortedRange)(SORT_T const *arr, size_t n) {
+  size_t i = 0;
+#ifdef SORT_SORTED_PREFIX
+  i = SORT_SORTED_PREFIX(arr, n);
+#endif
+  for (; i + 1 < n; i++) {
+    if (SORT_LESS(arr[i + 1], arr[i]))
+      return false;
+  }
+  return true;
+}
+
+#ifdef SORT_FIELD
+// Points d'entrée sur GenericData / tableaux non typés (tables de dispatch)
+static void SORT_NAME(RunBubble)(GenericData *data) {
+  SORT_NAME(BubbleSort)(data->data.SORT_FIELD, data->size);
+}
+
+static void SORT_NAME(RunInsertion)(GenericData *data) {
+  SORT_NAME(InsertionSort)(data->data.SORT_FIELD, data->size);
+}
+
+static void SORT_NAME(RunShell)(GenericData *data) {
+  SORT_NAME(ShellSort)(data->data.SORT_FIELD, data->size);
+}
+
+static void SORT_NAME(RunQuick)(GenericData *data) {
+  SORT_NAME(QuickSort)(data->data.SORT_FIELD, 0, (ptrdiff_t)data->size - 1);
+}
+
+static void SORT_NAME(RunIntro)(GenericData *data) {
+  SORT_NAME(IntroSort)(data->data.SORT_FIELD, data->size);
+}
+
+static void SORT_NAME(RunMerge)(GenericData *data) {
+  SORT_NAME(MergeSort)(data->data.SORT_FIELD, data->size);
+}
+
+static void SORT_NAME(RunTim)(GenericData *data) {
+  SORT_NAME(TimSort)(data->data.SORT_FIELD, data->size);
+}
+
+#ifdef SORT_EXTERNAL
+static void SORT_NAME(RunExternal)(GenericData *data) {
+  SORT_NAME(ExternalSort)(data->data.SORT_FIELD, data->size);
+}
+#endif
+
+static void SORT_NAME(IntroBlock)(void *base, size_t lo, size_t hi) {
+  SORT_NAME(IntroSort)((SORT_T *)base + lo, hi - lo);
+}
+
+static void SORT_NAME(MergeBlock)(const void *src, void *dst, size_t a_lo,
+                                  size_t a_hi, size_t b_hi, size_t k_begin,
+                                  size_t k_end) {
+  SORT_T const *s = (SORT_T const *)src;
+  SORT_NAME(MergeRange)(s + a_lo, a_hi - a_lo, s + a_hi, b_hi - a_hi, k_begin,
+                        k_end, (SORT_T *)dst + a_lo);
+}
+
+// Vérifie (si check_order) l'ordre de [lo, hi), plus la paire (hi - 1, hi)
+// si hi < n, et ajoute à *sum (si non NULL) l'empreinte des éléments de
+// [lo, hi). Ordre et empreinte sont calculés tuile par tuile: une tuile est
+// lue une seule fois depuis la mémoire, la seconde passe la trouve en cache.
+static bool SORT_NAME(VerifyRange)(const void *base, size_t lo, size_t hi,
+                                   size_t n, bool check_order,
+                                   unsigned long long *sum) {
+  SORT_T const *arr = (SORT_T const *)base;
+  unsigned long long acc = 0;
+  for (size_t t = lo; t < hi; t += VERIFY_TILE) {
+    size_t end = (hi - t < VERIFY_TILE) ? hi : t + VERIFY_TILE;
+    size_t pairs_end = (end < n) ? end + 1 : end;
+    if (check_order && !SORT_NAME(IsSortedRange)(arr + t, pairs_end - t))
+      return false;
+    if (sum) {
+      for (size_t i = t; i < end; i++)
+        acc += SORT_HASH(arr[i]);
+    }
+  }
+  if (sum)
+    *sum += acc;
+  return true;
+}
+#undef SORT_FIELD
+#endif
+
+#undef SORT_EXTERNAL
+#undef SORT_HASH
+#undef SORT_SORTED_PREFIX
+#undef SORT_SMALL_SORT
+#undef SORT_NAME
+#undef SORT_CAT
+#undef SORT_CAT_
+#undef SORT_LESS
+#undef SORT_T
+#undef SORT_SUFFIX
@@ -2,7 +2,18 @@
  * SORTING.C - Implémentation des algorithmes de tri avec support multi-types
  */
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+#endif
+
 #include "sorting.h"
+#include "dataset.h"
+#include "hwcounters.h"
+#include "pagealloc.h"
+#include <limits.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,15 +23,81 @@
 #include <windows.h>
 #else
 #include <pthread.h>
-#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// Accès atomiques aux compteurs partagés avec l'UI (C99: builtins GCC)
+#if defined(__GNUC__)
+#define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define ATOMIC_CAS(p, old, v)                                                  \
+  __atomic_compare_exchange_n((p), &(long){old}, (v), false,                   \
+                              __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define SORT_THREAD_LOCAL __thread
+#else
+#define ATOMIC_LOAD(p) (*(p))
+#define ATOMIC_STORE(p, v) (*(p) = (v))
+#define ATOMIC_ADD(p, v) (*(p) += (v))
+#define ATOMIC_CAS(p, old, v)                                                  \
+  (InterlockedCompareExchange((p), (v), (old)) == (old))
+#define SORT_THREAD_LOCAL __declspec(thread)
 #endif
 
 // Noms des algorithmes
 const char *SORT_NAMES[SORT_COUNT] = {"Bubble Sort", "Insertion Sort",
-                                      "Shell Sort", "Quick Sort"};
+                                      "Shell Sort", "Quick Sort",
+                                      "Intro Sort", "Radix Sort",
+                                      "Parallel Sort", "Counting Sort",
+                                      "Merge Sort", "Tim Sort",
+                                      "External Sort", "Multikey Sort",
+                                      "Auto Sort"};
+
+// Tri parallèle: taille minimale d'un bloc par thread
+#define PARALLEL_MIN_CHUNK 4096
+
+// Introsort: en dessous de ce seuil, tri par insertion; au-dessus du second,
+// pivot "ninther" (médiane de 3 médianes de 3)
+#define INTRO_INSERTION_CUTOFF 16
+#define INTRO_NINTHER_THRESHOLD 128
+
+// Tri fusion: taille des blocs triés par insertion avant les fusions
+#define MERGE_RUN 16
+
+// TimSort: taille minimale pour découper en suites, seuil d'entrée en mode
+// galop, profondeur max de la pile de suites (longueurs en croissance
+// au moins de Fibonacci: 64 suffit pour tout n représentable)
+#define TIM_MIN_MERGE 32
+#define TIM_MIN_GALLOP 7
+#define TIM_MAX_RUNS 64
+
+// Tri externe: budget mémoire par défaut (suite triée en mémoire + tampons
+// de fusion) et taille minimale d'un bloc de lecture par suite
+#define EXTERNAL_DEFAULT_MEMORY (8u << 20)
+#define EXTERNAL_MIN_BLOCK 1024
+
+// Tri multiclé: taille des groupes finis par insertion (au-delà de
+// IntroDepthLimit partitions, un groupe passe au tri par tas)
+#define MULTIKEY_SMALL 16
+
+// Tri adaptatif: éléments échantillonnés, part maximale de ruptures entre
+// voisins pour choisir TimSort (suites de 32 en moyenne)
+#define AUTO_SAMPLE 256
+#define AUTO_RUN_BREAKS (1.0 / 32)
+
+// Calibration: tailles testées (petites: insertion; grandes: radix et
+// parallèle), éléments triés par mesure, meilleur temps de quelques essais.
+// Le seuil d'insertion ne bouge que sur un écart net (MARGIN) entre les
+// deux meilleurs temps: le bruit d'une mesure ne le fait plus tomber à 0.
+#define AUTO_CALIBRATION_BATCH (1 << 16)
+#define AUTO_CALIBRATION_REPS 5
+#define AUTO_CALIBRATION_MARGIN 1.15
+#define AUTO_LADDER_MAX (1 << 18)
 
 // ==================== FONCTIONS UTILITAIRES ====================
 
+// Horloge monotone (secondes): insensible aux réglages de l'heure système
+// et, avec CLOCK_MONOTONIC_RAW, aux corrections progressives de NTP
 static double GetHighResTime(void) {
 #ifdef _WIN32
   LARGE_INTEGER freq, count;
@@ -28,12 +105,137 @@ static double GetHighResTime(void) {
   QueryPerformanceCounter(&count);
   return (double)count.QuadPart / (double)freq.QuadPart;
 #else
-  struct timeval tv;
-  gettimeofday(&tv, NULL);
-  return tv.tv_sec + tv.tv_usec / 1000000.0;
+  struct timespec ts;
+#ifdef CLOCK_MONOTONIC_RAW
+  if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts) != 0)
+#endif
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
 #endif
 }
 
+// Profondeur max de récursion avant bascule en heapsort: 2*floor(log2(n))
+static int IntroDepthLimit(size_t n) {
+  int depth = 0;
+  while (n > 1) {
+    depth++;
+    n >>= 1;
+  }
+  return 2 * depth;
+}
+
+// TimSort: longueur minimale des suites, dans [TIM_MIN_MERGE/2,
+// TIM_MIN_MERGE], choisie pour que n/minrun soit proche d'une puissance de 2
+static size_t TimMinRun(size_t n) {
+  size_t r = 0;
+  while (n >= TIM_MIN_MERGE) {
+    r |= n & 1;
+    n >>= 1;
+  }
+  return n + r;
+}
+
+// Tri externe: budget mémoire (0 = EXTERNAL_DEFAULT_MEMORY)
+static size_t g_external_memory = 0;
+
+void SetExternalMemory(size_t bytes) { g_external_memory = bytes; }
+
+size_t GetExternalMemory(void) {
+  return g_external_memory > 0 ? g_external_memory : EXTERNAL_DEFAULT_MEMORY;
+}
+
+// Éléments par suite: tout le budget, au moins quelques blocs de lecture
+static int ExternalRunLength(size_t elem_size) {
+  size_t len = GetExternalMemory() / elem_size;
+  if (len < 4 * EXTERNAL_MIN_BLOCK)
+    len = 4 * EXTERNAL_MIN_BLOCK;
+  return len > INT_MAX ? INT_MAX : (int)len;
+}
+
+// Éléments par bloc de lecture: le budget est partagé entre les suites
+static int ExternalBlockLength(size_t elem_size, size_t runs) {
+  size_t len = GetExternalMemory() / elem_size / runs;
+  if (len < EXTERNAL_MIN_BLOCK)
+    len = EXTERNAL_MIN_BLOCK;
+  return len > (size_t)ExternalRunLength(elem_size)
+             ? ExternalRunLength(elem_size)
+             : (int)len;
+}
+
+// ==================== PROGRESSION ET ARRÊT COOPÉRATIF ====================
+
+// Les noyaux accumulent leurs compteurs dans des variables locales au thread
+// et ne les publient dans le SortProgress partagé que toutes les
+// PROGRESS_PUBLISH_INTERVAL opérations (comparaisons + déplacements); la
+// demande d'arrêt est relue à chaque publication. Sans SortProgress attaché
+// (bench, appel direct), les compteurs sont simplement remis à zéro.
+#define PROGRESS_PUBLISH_INTERVAL (1LL << 16)
+
+// Les boucles d'insertion appellent SortTick toutes les SORT_TICK_MASK + 1
+// itérations
+#define SORT_TICK_MASK 1023
+
+static SORT_THREAD_LOCAL SortProgress *tls_progress = NULL;
+static SORT_THREAD_LOCAL bool tls_stop = false;
+static SORT_THREAD_LOCAL long long tls_comparisons, tls_moves, tls_passes;
+
+static bool SortPublish(void) {
+  SortProgress *p = tls_progress;
+  if (p) {
+    ATOMIC_ADD(&p->comparisons, tls_comparisons);
+    ATOMIC_ADD(&p->moves, tls_moves);
+    ATOMIC_ADD(&p->passes, tls_passes);
+    if (ATOMIC_LOAD(&p->should_stop))
+      tls_stop = true;
+  }
+  tls_comparisons = tls_moves = tls_passes = 0;
+  return tls_stop;
+}
+
+// Ajoute du travail aux compteurs; renvoie true si l'arrêt est demandé
+static inline bool SortTick(long long comparisons, long long moves,
+                            long long passes) {
+  tls_comparisons += comparisons;
+  tls_moves += moves;
+  tls_passes += passes;
+  if (tls_stop)
+    return true;
+  if (tls_comparisons + tls_moves < PROGRESS_PUBLISH_INTERVAL)
+    return false;
+  return SortPublish();
+}
+
+static bool SortStopRequested(void) {
+  if (!tls_stop && tls_progress && ATOMIC_LOAD(&tls_progress->should_stop))
+    tls_stop = true;
+  return tls_stop;
+}
+
+// Rattache le thread courant à un SortProgress (NULL = détacher)
+static void SortProgressAttach(SortProgress *progress) {
+  SortPublish();
+  tls_progress = progress;
+  tls_stop = false;
+}
+
+// Note du tri en cours (décision prise par l'algorithme), effacée par
+// TimedSortGeneric et recopiée dans SortThread.note en fin de tri
+static SORT_THREAD_LOCAL char tls_note[SORT_NOTE_SIZE];
+
+static void SortNote(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  vsnprintf(tls_note, sizeof(tls_note), format, args);
+  va_end(args);
+}
+
+const char *SortLastNote(void) { return tls_note; }
+
+// Compteurs matériels du dernier TimedSortGeneric du thread courant
+static SORT_THREAD_LOCAL HwCounterSample tls_counters;
+
+HwCounterSample SortLastCounters(void) { return tls_counters; }
+
 // ==================== FORMATAGE TEMPS ====================
 
 void FormatTimeString(double seconds, char *buffer, int buf_size) {
@@ -63,88 +265,641 @@ void FormatTimeString(double seconds, char *buffer, int buf_size) {
   }
 }
 
+// ==================== STATISTIQUES DE MESURE ====================
+
+static int CompareDouble(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+// Rang (1..n/2) de la borne basse de l'intervalle de confiance à 95 % de la
+// médiane: plus grand j tel que P(B < j) <= 2.5 %, B ~ Binomiale(n, 1/2)
+static int MedianCiRank(int n) {
+  double log_half_n = n * log(0.5);
+  double cumulative = 0;
+  int j = 0;
+  while (j < n / 2) {
+    double p = exp(lgamma(n + 1.0) - lgamma(j + 1.0) - lgamma(n - j + 1.0) +
+                   log_half_n);
+    if (cumulative + p > 0.025)
+      break;
+    cumulative += p;
+    j++;
+  }
+  return j > 0 ? j : 1;
+}
+
+SortStats ComputeSortStats(double *samples, int count) {
+  SortStats st;
+  memset(&st, 0, sizeof(st));
+  if (count <= 0)
+    return st;
+  qsort(samples, count, sizeof(double), CompareDouble);
+
+  double sum = 0;
+  for (int i = 0; i < count; i++)
+    sum += samples[i];
+  double sq = 0;
+  for (int i = 0; i < count; i++)
+    sq += (samples[i] - sum / count) * (samples[i] - sum / count);
+
+  st.count = count;
+  st.min = samples[0];
+  st.max = samples[count - 1];
+  st.mean = sum / count;
+  st.stddev = count > 1 ? sqrt(sq / (count - 1)) : 0;
+  st.median = (count % 2) ? samples[count / 2]
+                          : 0.5 * (samples[count / 2 - 1] + samples[count / 2]);
+
+  // Percentile 95 par rang le plus proche
+  int rank = (int)(0.95 * count + 0.999999);
+  if (rank < 1)
+    rank = 1;
+  st.p95 = samples[rank - 1];
+
+  // Statistiques d'ordre: aucune hypothèse sur la loi des temps, insensible
+  // aux valeurs aberrantes (interruption, migration de cœur)
+  int ci = MedianCiRank(count);
+  st.ci_low = samples[ci - 1];
+  st.ci_high = samples[count - ci];
+  return st;
+}
+
+const char *SCALING_MODEL_NAMES[SCALING_MODEL_COUNT] = {"n", "n log n",
+                                                        "n^2"};
+
+static double ScalingModelLog(ScalingModel model, double n) {
+  switch (model) {
+  case SCALING_LINEAR:
+    return log(n);
+  case SCALING_NLOGN:
+    return log(n) + log(log2(n));
+  default:
+    return 2.0 * log(n);
+  }
+}
+
+bool FitSortScaling(const double *sizes, const double *times, int count,
+                    ScalingFit *fit) {
+  memset(fit, 0, sizeof(ScalingFit));
+
+  // Moindres carrés en log: les petites tailles pèsent autant que les
+  // grandes (erreur relative) et la pente est l'exposant empirique
+  double sx = 0, sy = 0;
+  int n = 0;
+  for (int i = 0; i < count; i++) {
+    if (times[i] <= 0 || sizes[i] < 2)
+      continue;
+    sx += log(sizes[i]);
+    sy += log(times[i]);
+    n++;
+  }
+  if (n < 2)
+    return false;
+  double mx = sx / n, my = sy / n;
+
+  double sxx = 0, sxy = 0;
+  for (int i = 0; i < count; i++) {
+    if (times[i] <= 0 || sizes[i] < 2)
+      continue;
+    double dx = log(sizes[i]) - mx;
+    sxx += dx * dx;
+    sxy += dx * (log(times[i]) - my);
+  }
+  if (sxx <= 0)
+    return false; // Une seule taille distincte
+
+  fit->points = n;
+  fit->exponent = sxy / sxx;
+  fit->intercept = my - fit->exponent * mx;
+
+  // t = c * f(n): log c = moyenne de log t - log f, écart = RMS du reste
+  for (int m = 0; m < SCALING_MODEL_COUNT; m++) {
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+      if (times[i] > 0 && sizes[i] >= 2)
+        sum += log(times[i]) - ScalingModelLog((ScalingModel)m, sizes[i]);
+    }
+    double log_c = sum / n;
+    double sq = 0;
+    for (int i = 0; i < count; i++) {
+      if (times[i] <= 0 || sizes[i] < 2)
+        continue;
+      double r =
+          log(times[i]) - ScalingModelLog((ScalingModel)m, sizes[i]) - log_c;
+      sq += r * r;
+    }
+    fit->coef[m] = exp(log_c);
+    fit->error[m] = sqrt(sq / n);
+    if (fit->error[m] < fit->error[fit->model])
+      fit->model = (ScalingModel)m;
+  }
+  return true;
+}
+
+// ==================== GÉNÉRATEUR PSEUDO-ALÉATOIRE ====================
+
+// xoshiro256** (état 256 bits), état initial tiré de la graine par
+// splitmix64. RngJump avance de 2^128 tirages: chaque bloc de génération
+// dispose ainsi de son propre flux, sans chevauchement.
+
+static unsigned long long SplitMix64(unsigned long long *x) {
+  unsigned long long z = (*x += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static inline unsigned long long Rotl64(unsigned long long x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+void RngSeed(SortRng *rng, unsigned long long seed) {
+  for (int i = 0; i < 4; i++)
+    rng->s[i] = SplitMix64(&seed);
+}
+
+unsigned long long RngNext(SortRng *rng) {
+  unsigned long long *s = rng->s;
+  unsigned long long result = Rotl64(s[1] * 5, 7) * 9;
+  unsigned long long t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = Rotl64(s[3], 45);
+  return result;
+}
+
+void RngJump(SortRng *rng) {
+  static const unsigned long long jump[4] = {
+      0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+      0x39ABDC4529B1661CULL};
+  unsigned long long s[4] = {0, 0, 0, 0};
+
+  for (int i = 0; i < 4; i++) {
+    for (int b = 0; b < 64; b++) {
+      if (jump[i] & (1ULL << b)) {
+        for (int k = 0; k < 4; k++)
+          s[k] ^= rng->s[k];
+      }
+      RngNext(rng);
+    }
+  }
+  memcpy(rng->s, s, sizeof(s));
+}
+
+unsigned long long RngRange(SortRng *rng, unsigned long long bound) {
+  if (bound == 0) // Plage entière de 2^64 valeurs (0 - bound / bound)
+    return RngNext(rng);
+  // Les tirages inférieurs à 2^64 mod bound sont rejetés: il reste un
+  // multiple exact de bound valeurs, donc r % bound est uniforme
+  unsigned long long threshold = (0 - bound) % bound;
+  unsigned long long r;
+  do {
+    r = RngNext(rng);
+  } while (r < threshold);
+  return r % bound;
+}
+
+double RngDouble(SortRng *rng) {
+  return (RngNext(rng) >> 11) * 0x1.0p-53; // 53 bits de mantisse
+}
+
 // ==================== GÉNÉRATION DE DONNÉES TYPÉES ====================
 
-long long *GenerateRandomInts(int size, long long min_val, long long max_val) {
-  long long *data = (long long *)malloc(size * sizeof(long long));
-  if (!data)
-    return NULL;
+// Les tableaux sont générés par blocs de GEN_BLOCK éléments répartis entre
+// les threads; le bloc b utilise le flux de la graine avancé de b sauts.
+// Le résultat ne dépend donc que de la graine, pas du nombre de threads.
+#define GEN_BLOCK (1 << 16)
+
+typedef void (*ParallelFunc)(int index, void *ctx);
+static void RunParallel(int count, ParallelFunc fn, void *ctx);
 
-  long long range = max_val - min_val + 1;
-  for (int i = 0; i < size; i++) {
-    // Générer un nombre aléatoire sur 64 bits
-    long long r = ((long long)rand() << 32) | rand();
-    data[i] = min_val + (r % range);
+typedef struct {
+  DataType type;
+  size_t size;
+  int blocks;
+  int threads;
+  unsigned long long seed;
+  void *out;
+  long long int_min;
+  unsigned long long int_range;
+  double float_min;
+  double float_range;
+  // Chaînes: longueurs tirées en première passe, puis caractères écrits à
+  // partir de l'offset de chaque bloc (block_rng reprend le flux du bloc)
+  int max_len;
+  unsigned char *lengths;
+  size_t *block_offset;
+  SortRng *block_rng;
+  char *arena;
+  bool fill_strings;
+} GenJob;
+
+static void GenerateBlock(GenJob *job, int block, SortRng *rng) {
+  size_t lo = (size_t)block * GEN_BLOCK;
+  size_t hi = (job->size - lo < GEN_BLOCK) ? job->size : lo + GEN_BLOCK;
+
+  switch (job->type) {
+  case DATA_TYPE_INT: {
+    long long *data = (long long *)job->out;
+    // Somme non signée: min + écart peut dépasser LLONG_MAX en chemin
+    for (size_t i = lo; i < hi; i++)
+      data[i] = (long long)((unsigned long long)job->int_min +
+                            RngRange(rng, job->int_range));
+    break;
   }
-  return data;
+  case DATA_TYPE_FLOAT: {
+    double *data = (double *)job->out;
+    for (size_t i = lo; i < hi; i++)
+      data[i] = job->float_min + RngDouble(rng) * job->float_range;
+    break;
+  }
+  case DATA_TYPE_CHAR: {
+    char *data = (char *)job->out;
+    for (size_t i = lo; i < hi; i++)
+      data[i] = 'A' + (char)RngRange(rng, 26); // A-Z
+    break;
+  }
+  case DATA_TYPE_STRING: {
+    if (!job->fill_strings) {
+      size_t bytes = 0;
+      for (size_t i = lo; i < hi; i++) {
+        // 3 à max_len caracteres (max_len exactement en dessous de 3)
+        job->lengths[i] =
+            job->max_len > 2
+                ? 3 + (unsigned char)RngRange(rng, job->max_len - 2)
+                : (unsigned char)job->max_len;
+        bytes += job->lengths[i] + 1;
+      }
+      job->block_offset[block] = bytes;
+      job->block_rng[block] = *rng;
+      break;
+    }
+    char **data = (char **)job->out;
+    char *cursor = job->arena + job->block_offset[block];
+    for (size_t i = lo; i < hi; i++) {
+      int len = job->lengths[i];
+      data[i] = cursor;
+      for (int j = 0; j < len; j++)
+        cursor[j] = 'a' + (char)RngRange(rng, 26);
+      cursor[len] = '\0';
+      cursor += len + 1;
+    }
+    break;
+  }
+  }
+}
+
+static void GenerateWorker(int index, void *ctx) {
+  GenJob *job = (GenJob *)ctx;
+  int first = (int)((long long)job->blocks * index / job->threads);
+  int last = (int)((long long)job->blocks * (index + 1) / job->threads);
+
+  // Seconde passe des chaînes: reprise du flux enregistré par bloc
+  if (job->fill_strings) {
+    for (int b = first; b < last; b++)
+      GenerateBlock(job, b, &job->block_rng[b]);
+    return;
+  }
+
+  SortRng rng;
+  RngSeed(&rng, job->seed);
+  for (int b = 0; b < first; b++)
+    RngJump(&rng);
+  for (int b = first; b < last; b++) {
+    SortRng block_rng = rng;
+    GenerateBlock(job, b, &block_rng);
+    RngJump(&rng);
+  }
+}
+
+static void RunGenJob(GenJob *job) {
+  job->blocks = (int)((job->size + GEN_BLOCK - 1) / GEN_BLOCK);
+  if (job->blocks == 0)
+    return;
+  job->threads = GetSortThreadCount();
+  if (job->threads > job->blocks)
+    job->threads = job->blocks;
+  RunParallel(job->threads, GenerateWorker, job);
 }
 
-double *GenerateRandomFloats(int size, double min_val, double max_val) {
-  double *data = (double *)malloc(size * sizeof(double));
+static GenJob MakeGenJob(DataType type, size_t size, unsigned long long seed,
+                         void *out) {
+  GenJob job;
+  memset(&job, 0, sizeof(job));
+  job.type = type;
+  job.size = size;
+  job.seed = seed;
+  job.out = out;
+  return job;
+}
+
+long long *GenerateRandomInts(size_t size, long long min_val, long long max_val,
+                              unsigned long long seed) {
+  if (min_val > max_val)
+    return NULL;
+  long long *data = (long long *)PageAlloc(size * sizeof(long long));
   if (!data)
     return NULL;
 
-  double range = max_val - min_val;
-  for (int i = 0; i < size; i++) {
-    data[i] = min_val + ((double)rand() / RAND_MAX) * range;
-  }
+  GenJob job = MakeGenJob(DATA_TYPE_INT, size, seed, data);
+  job.int_min = min_val;
+  // Écart calculé en non signé (max - min déborde un long long); la plage
+  // complète donne 0, que RngRange traite comme 2^64
+  job.int_range = (unsigned long long)max_val - (unsigned long long)min_val + 1;
+  RunGenJob(&job);
   return data;
 }
 
-char *GenerateRandomChars(int size) {
-  char *data = (char *)malloc(size * sizeof(char));
+double *GenerateRandomFloats(size_t size, double min_val, double max_val,
+                             unsigned long long seed) {
+  double *data = (double *)PageAlloc(size * sizeof(double));
   if (!data)
     return NULL;
 
-  for (int i = 0; i < size; i++) {
-    data[i] = 'A' + (rand() % 26); // A-Z
-  }
+  GenJob job = MakeGenJob(DATA_TYPE_FLOAT, size, seed, data);
+  job.float_min = min_val;
+  job.float_range = max_val - min_val;
+  RunGenJob(&job);
   return data;
 }
 
-char **GenerateRandomStrings(int size, int max_len) {
-  char **data = (char **)malloc(size * sizeof(char *));
+char *GenerateRandomChars(size_t size, unsigned long long seed) {
+  char *data = (char *)PageAlloc(size * sizeof(char));
   if (!data)
     return NULL;
 
-  for (int i = 0; i < size; i++) {
-    int len = 3 + (rand() % (max_len - 2)); // 3 à max_len caracteres
-    data[i] = (char *)malloc((len + 1) * sizeof(char));
-    for (int j = 0; j < len; j++) {
-      data[i][j] = 'a' + (rand() % 26);
+  GenJob job = MakeGenJob(DATA_TYPE_CHAR, size, seed, data);
+  RunGenJob(&job);
+  return data;
+}
+
+char **GenerateRandomStrings(size_t size, int max_len, unsigned long long seed,
+                             char **arena, size_t *arena_size) {
+  char **data = (char **)PageAlloc(size * sizeof(char *));
+  GenJob job = MakeGenJob(DATA_TYPE_STRING, size, seed, data);
+  // Longueurs rangées sur un octet
+  job.max_len = max_len < 0 ? 0 : max_len > UCHAR_MAX ? UCHAR_MAX : max_len;
+  int blocks = (int)((size + GEN_BLOCK - 1) / GEN_BLOCK);
+  job.lengths = (unsigned char *)malloc(size > 0 ? size : 1);
+  job.block_offset = (size_t *)malloc(((size_t)blocks + 1) * sizeof(size_t));
+  job.block_rng = (SortRng *)malloc(((size_t)blocks + 1) * sizeof(SortRng));
+  bool ok = data && job.lengths && job.block_offset && job.block_rng;
+
+  if (ok) {
+    // Passe 1: longueurs et taille de chaque bloc
+    RunGenJob(&job);
+
+    // Offsets des blocs dans l'arène
+    size_t total = 0;
+    for (int b = 0; b < blocks; b++) {
+      size_t bytes = job.block_offset[b];
+      job.block_offset[b] = total;
+      total += bytes;
     }
-    data[i][len] = '\0';
+
+    job.arena = (char *)PageAlloc(total);
+    ok = job.arena != NULL;
+    *arena_size = total;
+  }
+
+  if (ok) {
+    // Passe 2: caractères
+    job.fill_strings = true;
+    RunGenJob(&job);
+    *arena = job.arena;
+  } else {
+    PageFree(data, size * sizeof(char *));
+    data = NULL;
   }
+
+  free(job.lengths);
+  free(job.block_offset);
+  free(job.block_rng);
   return data;
 }
 
-GenericData *GenerateTypedData(int size, DataType type) {
+bool SetStringData(GenericData *gd, char *const *strings, size_t size) {
+  size_t total = 0;
+  for (size_t i = 0; i < size; i++)
+    total += strlen(strings[i]) + 1;
+
+  char **data = (char **)PageAlloc(size * sizeof(char *));
+  char *block = (char *)PageAlloc(total);
+  if (!data || !block) {
+    PageFree(data, size * sizeof(char *));
+    PageFree(block, total);
+    return false;
+  }
+
+  char *cursor = block;
+  for (size_t i = 0; i < size; i++) {
+    size_t len = strlen(strings[i]) + 1;
+    memcpy(cursor, strings[i], len);
+    data[i] = cursor;
+    cursor += len;
+  }
+
+  gd->data.string_data = data;
+  gd->string_arena = block;
+  gd->arena_size = total;
+  return true;
+}
+
+// ==================== DISTRIBUTIONS ====================
+
+const char *DIST_NAMES[DIST_COUNT] = {"Aleatoire", "Trie", "Inverse",
+                                      "Presque trie", "Peu uniques",
+                                      "Orgue", "Zipf"};
+
+#define DIST_NEARLY_SORTED_RATE 100 // Un échange pour 100 éléments
+#define DIST_FEW_UNIQUE_VALUES 16
+#define DIST_ZIPF_VALUES 1000 // Rangs distincts (fréquence du rang k ~ 1/k)
+
+static void SwapElements(char *a, char *b, size_t size) {
+  char temp[sizeof(long long)];
+  memcpy(temp, a, size);
+  memcpy(a, b, size);
+  memcpy(b, temp, size);
+}
+
+// Remplit le tableau avec des valeurs tirées de ses pool_size premiers
+// éléments; le rang k est tiré selon cdf (NULL = équiprobable)
+static void FillFromPool(char *base, size_t n, size_t size, int pool_size,
+                         const double *cdf, SortRng *rng) {
+  char *pool = (char *)malloc((size_t)pool_size * size);
+  if (!pool)
+    return;
+  memcpy(pool, base, (size_t)pool_size * size);
+
+  for (size_t i = 0; i < n; i++) {
+    int k;
+    if (cdf) {
+      // Recherche dichotomique du premier rang dont la cdf dépasse u
+      double u = RngDouble(rng) * cdf[pool_size - 1];
+      int lo = 0, hi = pool_size - 1;
+      while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (cdf[mid] <= u)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      k = lo;
+    } else {
+      k = (int)RngRange(rng, pool_size);
+    }
+    memcpy(base + i * size, pool + (size_t)k * size, size);
+  }
+  free(pool);
+}
+
+// Transforme des données uniformes selon la distribution demandée. Pour les
+// chaînes seuls les pointeurs sont réordonnés ou dupliqués (même arène).
+static void ApplyDistribution(GenericData *gd, DataDistribution dist,
+                              unsigned long long seed) {
+  size_t n = gd->size;
+  if (n < 2 || dist == DIST_UNIFORM)
+    return;
+
+  size_t size = GenericElementSize(gd->type);
+  char *base = (char *)GenericDataPointer(gd);
+  SortRng rng;
+  RngSeed(&rng, ~seed); // Flux distinct de celui des valeurs
+
+  switch (dist) {
+  case DIST_SORTED:
+    ParallelSortGeneric(gd, 0);
+    break;
+  case DIST_REVERSED:
+    ParallelSortGeneric(gd, 0);
+    for (size_t i = 0, j = n - 1; i < j; i++, j--)
+      SwapElements(base + i * size, base + j * size, size);
+    break;
+  case DIST_NEARLY_SORTED: {
+    ParallelSortGeneric(gd, 0);
+    size_t swaps = n / DIST_NEARLY_SORTED_RATE + 1;
+    for (size_t s = 0; s < swaps; s++) {
+      size_t i = RngRange(&rng, n), j = RngRange(&rng, n);
+      SwapElements(base + i * size, base + j * size, size);
+    }
+    break;
+  }
+  case DIST_FEW_UNIQUE: {
+    int values = n < DIST_FEW_UNIQUE_VALUES ? (int)n : DIST_FEW_UNIQUE_VALUES;
+    FillFromPool(base, n, size, values, NULL, &rng);
+    break;
+  }
+  case DIST_ORGAN_PIPE: {
+    // Rangs pairs croissants puis rangs impairs décroissants
+    ParallelSortGeneric(gd, 0);
+    char *temp = (char *)malloc(n * size);
+    if (!temp)
+      break;
+    size_t front = 0, back = n - 1;
+    for (size_t i = 0; i < n; i++) {
+      size_t dst = (i % 2 == 0) ? front++ : back--;
+      memcpy(temp + dst * size, base + i * size, size);
+    }
+    memcpy(base, temp, n * size);
+    free(temp);
+    break;
+  }
+  case DIST_ZIPF: {
+    int values = n < DIST_ZIPF_VALUES ? (int)n : DIST_ZIPF_VALUES;
+    double cdf[DIST_ZIPF_VALUES];
+    double total = 0;
+    for (int k = 0; k < values; k++) {
+      total += 1.0 / (k + 1);
+      cdf[k] = total;
+    }
+    FillFromPool(base, n, size, values, cdf, &rng);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+GenericData *GenerateTypedData(size_t size, DataType type,
+                               DataDistribution dist,
+                               unsigned long long seed) {
   GenericData *gd = (GenericData *)malloc(sizeof(GenericData));
   if (!gd)
     return NULL;
 
   gd->type = type;
   gd->size = size;
+  gd->seed = seed;
+  gd->dist = dist;
+  gd->has_checksum = false;
+  gd->checksum = 0;
+  gd->string_arena = NULL;
+  gd->arena_size = 0;
+  gd->mapping = NULL;
+  gd->mapping_size = 0;
 
   switch (type) {
   case DATA_TYPE_INT:
     // Plage millions à milliards
-    gd->data.int_data = GenerateRandomInts(size, 1000000LL, 10000000000LL);
+    gd->data.int_data =
+        GenerateRandomInts(size, 1000000LL, 10000000000LL, seed);
     break;
   case DATA_TYPE_FLOAT:
-    gd->data.float_data = GenerateRandomFloats(size, 1.0, 1000000.0);
+    gd->data.float_data = GenerateRandomFloats(size, 1.0, 1000000.0, seed);
     break;
   case DATA_TYPE_CHAR:
-    gd->data.char_data = GenerateRandomChars(size);
+    gd->data.char_data = GenerateRandomChars(size, seed);
     break;
   case DATA_TYPE_STRING:
-    gd->data.string_data = GenerateRandomStrings(size, 10);
+    gd->data.string_data = GenerateRandomStrings(
+        size, 10, seed, &gd->string_arena, &gd->arena_size);
     break;
   }
 
+  // Mémoire insuffisante: rien n'est renvoyé plutôt qu'un tableau NULL
+  if (!GenericDataPointer(gd)) {
+    free(gd);
+    return NULL;
+  }
+  ApplyDistribution(gd, dist, seed);
+  UpdateGenericDataChecksum(gd);
   return gd;
 }
 
+size_t GenericElementSize(DataType type) {
+  switch (type) {
+  case DATA_TYPE_INT:
+    return sizeof(long long);
+  case DATA_TYPE_FLOAT:
+    return sizeof(double);
+  case DATA_TYPE_CHAR:
+    return sizeof(char);
+  case DATA_TYPE_STRING:
+    return sizeof(char *);
+  }
+  return 0;
+}
+
+void *GenericDataPointer(GenericData *data) {
+  switch (data->type) {
+  case DATA_TYPE_INT:
+    return data->data.int_data;
+  case DATA_TYPE_FLOAT:
+    return data->data.float_data;
+  case DATA_TYPE_CHAR:
+    return data->data.char_data;
+  case DATA_TYPE_STRING:
+    return data->data.string_data;
+  }
+  return NULL;
+}
+
 GenericData *CopyGenericData(const GenericData *src) {
   if (!src)
     return NULL;
@@ -155,74 +910,146 @@ GenericData *CopyGenericData(const GenericData *src) {
 
   copy->type = src->type;
   copy->size = src->size;
-
+  copy->seed = src->seed;
+  copy->dist = src->dist;
+  copy->has_checksum = src->has_checksum;
+  copy->checksum = src->checksum;
+  copy->string_arena = NULL;
+  copy->arena_size = 0;
+  copy->mapping = NULL;
+  copy->mapping_size = 0;
+
+  size_t bytes = src->size * GenericElementSize(src->type);
+  bool ok = false;
   switch (src->type) {
   case DATA_TYPE_INT:
-    copy->data.int_data = (long long *)malloc(src->size * sizeof(long long));
-    memcpy(copy->data.int_data, src->data.int_data,
-           src->size * sizeof(long long));
-    break;
   case DATA_TYPE_FLOAT:
-    copy->data.float_data = (double *)malloc(src->size * sizeof(double));
-    memcpy(copy->data.float_data, src->data.float_data,
-           src->size * sizeof(double));
-    break;
   case DATA_TYPE_CHAR:
-    copy->data.char_data = (char *)malloc(src->size * sizeof(char));
-    memcpy(copy->data.char_data, src->data.char_data, src->size * sizeof(char));
+    // Pages placées par le thread appelant, celui qui triera la copie
+    copy->data.int_data = (long long *)PageAlloc(bytes);
+    ok = copy->data.int_data != NULL;
+    if (!ok)
+      break;
+    PagePrefault(copy->data.int_data, bytes);
+    memcpy(GenericDataPointer(copy), GenericDataPointer((GenericData *)src),
+           bytes);
     break;
   case DATA_TYPE_STRING:
-    copy->data.string_data = (char **)malloc(src->size * sizeof(char *));
-    for (int i = 0; i < src->size; i++) {
-      copy->data.string_data[i] = strdup(src->data.string_data[i]);
+    // Pointeurs vers le bloc d'une autre structure: copie chaîne par chaîne
+    if (!src->string_arena) {
+      ok = SetStringData(copy, src->data.string_data, src->size);
+      break;
+    }
+    // Une copie du bloc, puis les pointeurs sont recalés sur la copie (l'ordre
+    // des pointeurs peut différer de l'ordre des chaînes dans le bloc)
+    copy->data.string_data = (char **)PageAlloc(bytes);
+    copy->string_arena = (char *)PageAlloc(src->arena_size);
+    ok = copy->data.string_data && copy->string_arena;
+    if (!ok) {
+      PageFree(copy->data.string_data, bytes);
+      PageFree(copy->string_arena, src->arena_size);
+      break;
+    }
+    PagePrefault(copy->data.string_data, bytes);
+    PagePrefault(copy->string_arena, src->arena_size);
+    copy->arena_size = src->arena_size;
+    memcpy(copy->string_arena, src->string_arena, src->arena_size);
+    for (size_t i = 0; i < src->size; i++) {
+      copy->data.string_data[i] =
+          copy->string_arena + (src->data.string_data[i] - src->string_arena);
     }
     break;
   }
 
+  // Mémoire insuffisante: rien n'est renvoyé, comme CopyGenericDataInto
+  if (!ok) {
+    free(copy);
+    return NULL;
+  }
   return copy;
 }
 
+GenericData *CopyGenericDataInto(GenericData *dst, const GenericData *src) {
+  if (!src)
+    return dst;
+  if (dst &&
+      (dst->type != src->type || dst->size != src->size || dst->mapping)) {
+    FreeGenericData(dst);
+    dst = NULL;
+  }
+
+  size_t bytes = src->size * GenericElementSize(src->type);
+  if (!dst) {
+    dst = (GenericData *)malloc(sizeof(GenericData));
+    if (!dst)
+      return NULL;
+    dst->type = src->type;
+    dst->size = src->size;
+    dst->string_arena = NULL;
+    dst->arena_size = 0;
+    dst->mapping = NULL;
+    dst->mapping_size = 0;
+    // Alloué et prérempli ici: dans RunSortThread, le thread qui va trier
+    // le tampon en touche les pages le premier (nœud NUMA local)
+    dst->data.int_data = (long long *)PageAlloc(bytes);
+    if (!dst->data.int_data) {
+      free(dst);
+      return NULL;
+    }
+    PagePrefault(dst->data.int_data, bytes);
+  } else if (dst->string_arena) {
+    // Le tampon possédait son bloc: il partage désormais celui de src
+    PageFree(dst->string_arena, dst->arena_size);
+    dst->string_arena = NULL;
+    dst->arena_size = 0;
+  }
+
+  dst->seed = src->seed;
+  dst->dist = src->dist;
+  dst->has_checksum = src->has_checksum;
+  dst->checksum = src->checksum;
+  memcpy(GenericDataPointer(dst), GenericDataPointer((GenericData *)src),
+         bytes);
+  return dst;
+}
+
 void FreeGenericData(GenericData *data) {
   if (!data)
     return;
 
-  switch (data->type) {
-  case DATA_TYPE_INT:
-    free(data->data.int_data);
-    break;
-  case DATA_TYPE_FLOAT:
-    free(data->data.float_data);
-    break;
-  case DATA_TYPE_CHAR:
-    free(data->data.char_data);
-    break;
-  case DATA_TYPE_STRING:
-    for (int i = 0; i < data->size; i++) {
-      free(data->data.string_data[i]);
-    }
-    free(data->data.string_data);
-    break;
+  if (data->mapping) {
+    // Données projetées: seul le tableau de pointeurs des chaînes est alloué
+    if (data->type == DATA_TYPE_STRING)
+      PageFree(data->data.string_data, data->size * sizeof(char *));
+    UnmapDataset(data->mapping, data->mapping_size);
+    free(data);
+    return;
   }
 
+  PageFree(GenericDataPointer(data),
+           data->size * GenericElementSize(data->type));
+  if (data->type == DATA_TYPE_STRING)
+    PageFree(data->string_arena, data->arena_size);
+
   free(data);
 }
 
 // ==================== ANCIENNES FONCTIONS (COMPATIBILITÉ) ====================
 
-int *GenerateRandomData(int size, int min_val, int max_val) {
+int *GenerateRandomData(size_t size, int min_val, int max_val) {
   int *data = (int *)malloc(size * sizeof(int));
   if (!data)
     return NULL;
 
   int range = max_val - min_val + 1;
-  for (int i = 0; i < size; i++) {
+  for (size_t i = 0; i < size; i++) {
     data[i] = min_val + rand() % range;
   }
   return data;
 }
 
-int *CopyData(const int *src, int size) {
-  if (!src || size <= 0)
+int *CopyData(const int *src, size_t size) {
+  if (!src || size == 0)
     return NULL;
   int *copy = (int *)malloc(size * sizeof(int));
   if (!copy)
@@ -233,441 +1060,1295 @@ int *CopyData(const int *src, int size) {
 
 void FreeData(int *data) { free(data); }
 
-// ==================== ALGORITHMES DE TRI - ENTIERS LONG ====================
-
-void BubbleSortInt(long long *arr, int n) {
-  for (int i = 0; i < n - 1; i++) {
-    bool swapped = false;
-    for (int j = 0; j < n - i - 1; j++) {
-      if (arr[j] > arr[j + 1]) {
-        long long temp = arr[j];
-        arr[j] = arr[j + 1];
-        arr[j + 1] = temp;
-        swapped = true;
-      }
-    }
-    if (!swapped)
-      break;
-  }
-}
+// ==================== RÉSEAUX DE TRI (SIMD) ====================
 
-void InsertionSortInt(long long *arr, int n) {
-  for (int i = 1; i < n; i++) {
-    long long key = arr[i];
-    int j = i - 1;
-    while (j >= 0 && arr[j] > key) {
-      arr[j + 1] = arr[j];
-      j--;
-    }
-    arr[j + 1] = key;
-  }
-}
+// Les feuilles de QuickSort (entiers et réels) d'au plus SMALL_SORT_MAX
+// éléments sont triées par un réseau bitonique tenu dans 4 registres AVX2
+// (4 x 4 valeurs 64 bits, complétées par le maximum du type). Le jeu
+// d'instructions est choisi à l'exécution (CPUID); sans AVX2, les feuilles
+// passent par le tri par insertion. IsSortedGeneric compare de même 4
+// (64 bits) ou 32 (char) paires voisines à la fois.
+#define SMALL_SORT_MAX 16
 
-void ShellSortInt(long long *arr, int n) {
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      long long temp = arr[i];
-      int j = i;
-      while (j >= gap && arr[j - gap] > temp) {
-        arr[j] = arr[j - gap];
-        j -= gap;
-      }
-      arr[j] = temp;
-    }
-  }
-}
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORT_SIMD_X86
+#include <immintrin.h>
+#define SIMD_TARGET __attribute__((target("avx2")))
+#endif
 
-static int PartitionInt(long long *arr, int low, int high) {
-  long long pivot = arr[high];
-  int i = low - 1;
-  for (int j = low; j < high; j++) {
-    if (arr[j] <= pivot) {
-      i++;
-      long long temp = arr[i];
-      arr[i] = arr[j];
-      arr[j] = temp;
-    }
-  }
-  long long temp = arr[i + 1];
-  arr[i + 1] = arr[high];
-  arr[high] = temp;
-  return i + 1;
+static bool SortHasAvx2(void) {
+#ifdef SORT_SIMD_X86
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
 }
 
-void QuickSortInt(long long *arr, int low, int high) {
-  if (low < high) {
-    int pi = PartitionInt(arr, low, high);
-    QuickSortInt(arr, low, pi - 1);
-    QuickSortInt(arr, pi + 1, high);
-  }
+const char *SortIsaName(void) { return SortHasAvx2() ? "AVX2" : "scalaire"; }
+
+const char *SortKernelIsa(SortAlgorithm algo, DataType type) {
+  if (algo == SORT_QUICK &&
+      (type == DATA_TYPE_INT || type == DATA_TYPE_FLOAT))
+    return SortIsaName();
+  return "scalaire";
 }
 
-// ==================== ALGORITHMES DE TRI - FLOAT ====================
+#ifdef SORT_SIMD_X86
+// Les valeurs 64 bits sont manipulées dans des __m256d; pour les entiers, la
+// comparaison se fait sur les mêmes bits vus comme des entiers signés. Les
+// paires sont échangées, jamais recalculées par min/max: -0.0 et +0.0
+// restent distincts, un NaN (jamais plus grand) reste en place.
+static inline SIMD_TARGET __m256d GreaterMask4(__m256d a, __m256d b,
+                                               bool ints) {
+  if (ints)
+    return _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_castpd_si256(a),
+                                                  _mm256_castpd_si256(b)));
+  return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+}
 
-void BubbleSortFloat(double *arr, int n) {
-  for (int i = 0; i < n - 1; i++) {
-    bool swapped = false;
-    for (int j = 0; j < n - i - 1; j++) {
-      if (arr[j] > arr[j + 1]) {
-        double temp = arr[j];
-        arr[j] = arr[j + 1];
-        arr[j + 1] = temp;
-        swapped = true;
-      }
-    }
-    if (!swapped)
-      break;
-  }
+static inline SIMD_TARGET void CompareExchange4(__m256d *a, __m256d *b,
+                                                bool ints) {
+  __m256d gt = GreaterMask4(*a, *b, ints);
+  __m256d lo = _mm256_blendv_pd(*a, *b, gt);
+  __m256d hi = _mm256_blendv_pd(*b, *a, gt);
+  *a = lo;
+  *b = hi;
 }
 
-void InsertionSortFloat(double *arr, int n) {
-  for (int i = 1; i < n; i++) {
-    double key = arr[i];
-    int j = i - 1;
-    while (j >= 0 && arr[j] > key) {
-      arr[j + 1] = arr[j];
-      j--;
-    }
-    arr[j + 1] = key;
-  }
+// Trie une séquence bitonique de 4 valeurs dans un registre. Chaque paire
+// est comparée une fois: la voie haute reprend la décision de la voie
+// basse, sinon deux valeurs égales mais distinctes seraient dupliquées.
+static inline SIMD_TARGET __m256d BitonicClean4(__m256d v, bool ints) {
+  __m256d p = _mm256_permute4x64_pd(v, 0x4E); // Distance 2
+  __m256d gt = GreaterMask4(v, p, ints);
+  gt = _mm256_blend_pd(gt, _mm256_permute4x64_pd(gt, 0x4E), 0xC);
+  v = _mm256_blendv_pd(v, p, gt);
+  p = _mm256_permute4x64_pd(v, 0xB1); // Distance 1
+  gt = GreaterMask4(v, p, ints);
+  gt = _mm256_blend_pd(gt, _mm256_permute4x64_pd(gt, 0xB1), 0xA);
+  return _mm256_blendv_pd(v, p, gt);
 }
 
-void ShellSortFloat(double *arr, int n) {
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      double temp = arr[i];
-      int j = i;
-      while (j >= gap && arr[j - gap] > temp) {
-        arr[j] = arr[j - gap];
-        j -= gap;
-      }
-      arr[j] = temp;
-    }
-  }
+// Fusionne deux registres triés: a reçoit les 4 plus petits, b les 4 autres
+static inline SIMD_TARGET void BitonicMerge4(__m256d *a, __m256d *b,
+                                            bool ints) {
+  *b = _mm256_permute4x64_pd(*b, 0x1B); // Inversion
+  CompareExchange4(a, b, ints);
+  *a = BitonicClean4(*a, ints);
+  *b = BitonicClean4(*b, ints);
 }
 
-static int PartitionFloat(double *arr, int low, int high) {
-  double pivot = arr[high];
-  int i = low - 1;
-  for (int j = low; j < high; j++) {
-    if (arr[j] <= pivot) {
-      i++;
-      double temp = arr[i];
-      arr[i] = arr[j];
-      arr[j] = temp;
-    }
-  }
-  double temp = arr[i + 1];
-  arr[i + 1] = arr[high];
-  arr[high] = temp;
-  return i + 1;
+// Trie 16 valeurs 64 bits en place
+static inline SIMD_TARGET void SortNetwork16(double *v, bool ints) {
+  __m256d r0 = _mm256_loadu_pd(v), r1 = _mm256_loadu_pd(v + 4);
+  __m256d r2 = _mm256_loadu_pd(v + 8), r3 = _mm256_loadu_pd(v + 12);
+
+  // Tri des 4 colonnes (réseau optimal à 5 comparateurs)
+  CompareExchange4(&r0, &r1, ints);
+  CompareExchange4(&r2, &r3, ints);
+  CompareExchange4(&r0, &r2, ints);
+  CompareExchange4(&r1, &r3, ints);
+  CompareExchange4(&r1, &r2, ints);
+
+  // Transposition: chaque registre contient une colonne triée
+  __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+  __m256d t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+  r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+  r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+  r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+  r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+  // 4 suites de 4 -> 2 suites de 8 -> 16
+  BitonicMerge4(&r0, &r1, ints);
+  BitonicMerge4(&r2, &r3, ints);
+  __m256d b0 = _mm256_permute4x64_pd(r3, 0x1B);
+  __m256d b1 = _mm256_permute4x64_pd(r2, 0x1B);
+  CompareExchange4(&r0, &b0, ints);
+  CompareExchange4(&r1, &b1, ints);
+  CompareExchange4(&r0, &r1, ints);
+  CompareExchange4(&b0, &b1, ints);
+  _mm256_storeu_pd(v, BitonicClean4(r0, ints));
+  _mm256_storeu_pd(v + 4, BitonicClean4(r1, ints));
+  _mm256_storeu_pd(v + 8, BitonicClean4(b0, ints));
+  _mm256_storeu_pd(v + 12, BitonicClean4(b1, ints));
 }
 
-void QuickSortFloat(double *arr, int low, int high) {
-  if (low < high) {
-    int pi = PartitionFloat(arr, low, high);
-    QuickSortFloat(arr, low, pi - 1);
-    QuickSortFloat(arr, pi + 1, high);
-  }
+static SIMD_TARGET void NetworkSortInt(long long *arr, size_t n) {
+  long long buf[SMALL_SORT_MAX];
+  for (size_t i = 0; i < SMALL_SORT_MAX; i++)
+    buf[i] = (i < n) ? arr[i] : LLONG_MAX;
+  SortNetwork16((double *)buf, true);
+  memcpy(arr, buf, n * sizeof(long long));
 }
 
-// ==================== ALGORITHMES DE TRI - CHAR ====================
+static SIMD_TARGET void NetworkSortFloat(double *arr, size_t n) {
+  double buf[SMALL_SORT_MAX];
+  for (size_t i = 0; i < SMALL_SORT_MAX; i++)
+    buf[i] = (i < n) ? arr[i] : HUGE_VAL;
+  SortNetwork16(buf, false);
+  memcpy(arr, buf, n * sizeof(double));
+}
 
-void BubbleSortChar(char *arr, int n) {
-  for (int i = 0; i < n - 1; i++) {
-    bool swapped = false;
-    for (int j = 0; j < n - i - 1; j++) {
-      if (arr[j] > arr[j + 1]) {
-        char temp = arr[j];
-        arr[j] = arr[j + 1];
-        arr[j + 1] = temp;
-        swapped = true;
-      }
-    }
-    if (!swapped)
+// Longueur du préfixe dont les paires voisines sont vérifiées: la boucle
+// s'arrête au premier bloc contenant une inversion, que l'appelant retrouve
+static SIMD_TARGET size_t SortedPrefixAvx2Int(const long long *arr,
+                                              size_t n) {
+  size_t i = 0;
+  for (; i + 4 < n; i += 4) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(arr + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(arr + i + 1));
+    __m256i gt = _mm256_cmpgt_epi64(a, b);
+    if (!_mm256_testz_si256(gt, gt))
       break;
   }
+  return i;
 }
 
-void InsertionSortChar(char *arr, int n) {
-  for (int i = 1; i < n; i++) {
-    char key = arr[i];
-    int j = i - 1;
-    while (j >= 0 && arr[j] > key) {
-      arr[j + 1] = arr[j];
-      j--;
-    }
-    arr[j + 1] = key;
+static SIMD_TARGET size_t SortedPrefixAvx2Float(const double *arr,
+                                                size_t n) {
+  size_t i = 0;
+  for (; i + 4 < n; i += 4) {
+    __m256d a = _mm256_loadu_pd(arr + i);
+    __m256d b = _mm256_loadu_pd(arr + i + 1);
+    if (_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)))
+      break;
   }
+  return i;
 }
 
-void ShellSortChar(char *arr, int n) {
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      char temp = arr[i];
-      int j = i;
-      while (j >= gap && arr[j - gap] > temp) {
-        arr[j] = arr[j - gap];
-        j -= gap;
-      }
-      arr[j] = temp;
-    }
+static SIMD_TARGET size_t SortedPrefixAvx2Char(const char *arr, size_t n) {
+  // Comparaison signée: si char est non signé, décalage de 0x80
+  const __m256i bias = _mm256_set1_epi8((CHAR_MIN < 0) ? 0 : (char)0x80);
+  size_t i = 0;
+  for (; i + 32 < n; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(arr + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(arr + i + 1));
+    __m256i gt = _mm256_cmpgt_epi8(_mm256_xor_si256(a, bias),
+                                   _mm256_xor_si256(b, bias));
+    if (!_mm256_testz_si256(gt, gt))
+      break;
   }
+  return i;
 }
+#endif
 
-static int PartitionChar(char *arr, int low, int high) {
-  char pivot = arr[high];
-  int i = low - 1;
-  for (int j = low; j < high; j++) {
-    if (arr[j] <= pivot) {
-      i++;
-      char temp = arr[i];
-      arr[i] = arr[j];
-      arr[j] = temp;
-    }
-  }
-  char temp = arr[i + 1];
-  arr[i + 1] = arr[high];
-  arr[high] = temp;
-  return i + 1;
+static size_t SortedPrefixInt(const long long *arr, size_t n) {
+#ifdef SORT_SIMD_X86
+  if (SortHasAvx2())
+    return SortedPrefixAvx2Int(arr, n);
+#endif
+  return 0;
 }
 
-void QuickSortChar(char *arr, int low, int high) {
-  if (low < high) {
-    int pi = PartitionChar(arr, low, high);
-    QuickSortChar(arr, low, pi - 1);
-    QuickSortChar(arr, pi + 1, high);
-  }
+static size_t SortedPrefixFloat(const double *arr, size_t n) {
+#ifdef SORT_SIMD_X86
+  if (SortHasAvx2())
+    return SortedPrefixAvx2Float(arr, n);
+#endif
+  return 0;
 }
 
-// ==================== ALGORITHMES DE TRI - STRING ====================
+static size_t SortedPrefixChar(const char *arr, size_t n) {
+#ifdef SORT_SIMD_X86
+  if (SortHasAvx2())
+    return SortedPrefixAvx2Char(arr, n);
+#endif
+  return 0;
+}
 
-void BubbleSortString(char **arr, int n) {
-  for (int i = 0; i < n - 1; i++) {
-    bool swapped = false;
-    for (int j = 0; j < n - i - 1; j++) {
-      if (strcmp(arr[j], arr[j + 1]) > 0) {
-        char *temp = arr[j];
-        arr[j] = arr[j + 1];
-        arr[j + 1] = temp;
-        swapped = true;
-      }
+// Feuilles de QuickSort (définies après l'instanciation des noyaux)
+static void SmallSortInt(long long *arr, size_t n);
+static void SmallSortFloat(double *arr, size_t n);
+
+// ==================== ALGORITHMES DE TRI ====================
+
+// Les noyaux (bulles, insertion, Shell, rapide, introsort, fusion) sont
+// écrits une seule fois dans sort_template.h et instanciés ici par type:
+// chaque instance a ses comparaisons en ligne, sans pointeur de fonction.
+
+// Éléments vérifiés par tuile (ordre puis empreinte, voir VerifyRange)
+#define VERIFY_TILE 4096
+
+// Empreinte d'un élément: bits mélangés par le finaliseur de splitmix64
+// (une valeur changée modifie la somme, quelle que soit sa position)
+static inline unsigned long long HashMix64(unsigned long long z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static inline unsigned long long HashDouble(double v) {
+  unsigned long long bits;
+  memcpy(&bits, &v, sizeof(bits));
+  return HashMix64(bits);
+}
+
+// FNV-1a sur les caractères, puis mélange
+static inline unsigned long long HashString(const char *s) {
+  unsigned long long h = 0xCBF29CE484222325ULL;
+  for (; *s; s++)
+    h = (h ^ (unsigned char)*s) * 0x100000001B3ULL;
+  return HashMix64(h);
+}
+
+#define SORT_SUFFIX Int
+#define SORT_T long long
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_FIELD int_data
+#define SORT_HASH(x) HashMix64((unsigned long long)(x))
+#define SORT_SMALL_SORT SmallSortInt
+#define SORT_SORTED_PREFIX SortedPrefixInt
+#define SORT_EXTERNAL
+#include "sort_template.h"
+
+#define SORT_SUFFIX Float
+#define SORT_T double
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_FIELD float_data
+#define SORT_HASH(x) HashDouble(x)
+#define SORT_SMALL_SORT SmallSortFloat
+#define SORT_SORTED_PREFIX SortedPrefixFloat
+#define SORT_EXTERNAL
+#include "sort_template.h"
+
+#define SORT_SUFFIX Char
+#define SORT_T char
+#define SORT_LESS(a, b) ((a) < (b))
+#define SORT_FIELD char_data
+#define SORT_HASH(x) HashMix64((unsigned char)(x))
+#define SORT_SORTED_PREFIX SortedPrefixChar
+#define SORT_EXTERNAL
+#include "sort_template.h"
+
+#define SORT_SUFFIX String
+#define SORT_T char *
+#define SORT_LESS(a, b) (strcmp((a), (b)) < 0)
+#define SORT_FIELD string_data
+#define SORT_HASH(x) HashString(x)
+#include "sort_template.h"
+
+// Anciennes fonctions pour compatibilité (int *, sans suffixe)
+#define SORT_SUFFIX
+#define SORT_T int
+#define SORT_LESS(a, b) ((a) < (b))
+#include "sort_template.h"
+
+// Réseau AVX2 si disponible, sinon tri par insertion (avec compteurs)
+static void SmallSortInt(long long *arr, size_t n) {
+#ifdef SORT_SIMD_X86
+  if (SortHasAvx2()) {
+    NetworkSortInt(arr, n);
+    SortTick(4LL * (long long)n, (long long)n, 0); // ~ n log2(16) comparaisons
+    return;
+  }
+#endif
+  InsertionRangeInt(arr, 0, (ptrdiff_t)n - 1);
+}
+
+// NaN n'est ordonné avec rien: le réseau le déplacerait autrement que le
+// tri par insertion des autres noyaux
+static bool HasNan(const double *arr, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (arr[i] != arr[i])
+      return true;
+  }
+  return false;
+}
+
+static void SmallSortFloat(double *arr, size_t n) {
+#ifdef SORT_SIMD_X86
+  if (SortHasAvx2() && !HasNan(arr, n)) {
+    NetworkSortFloat(arr, n);
+    SortTick(4LL * (long long)n, (long long)n, 0);
+    return;
+  }
+#endif
+  InsertionRangeFloat(arr, 0, (ptrdiff_t)n - 1);
+}
+
+// Opérations par type hors noyaux (blocs du tri parallèle, vérification)
+typedef struct {
+  void (*intro_block)(void *base, size_t lo, size_t hi);
+  void (*merge_block)(const void *src, void *dst, size_t a_lo, size_t a_hi,
+                      size_t b_hi, size_t k_begin, size_t k_end);
+  bool (*verify)(const void *base, size_t lo, size_t hi, size_t n,
+                 bool check_order, unsigned long long *sum);
+} SortTypeOps;
+
+#define SORT_TYPE_OPS(S) {IntroBlock##S, MergeBlock##S, VerifyRange##S}
+
+static const SortTypeOps TYPE_OPS[] = {
+    [DATA_TYPE_INT] = SORT_TYPE_OPS(Int),
+    [DATA_TYPE_FLOAT] = SORT_TYPE_OPS(Float),
+    [DATA_TYPE_CHAR] = SORT_TYPE_OPS(Char),
+    [DATA_TYPE_STRING] = SORT_TYPE_OPS(String),
+};
+
+// ==================== TRI PAR BASE (LSD) ====================
+
+// Radix LSD sur des clés 64 bits non signées: chiffres de 11 bits, 6 passes.
+// Les RADIX_PASSES histogrammes (un par passe) sont calculés en un seul
+// parcours; une passe dont tous les éléments tombent dans le même seau est
+// sautée. Le tampon scratch est réutilisé d'une passe à l'autre (ping-pong).
+#define RADIX_BITS 11
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES ((64 + RADIX_BITS - 1) / RADIX_BITS)
+#define RADIX_SIGN_BIT 0x8000000000000000ULL
+
+// false, clés intactes, si les histogrammes ne peuvent pas être alloués
+static bool RadixSortKeys(unsigned long long *keys, unsigned long long *scratch,
+                          size_t n) {
+  static const int digit_mask = RADIX_BUCKETS - 1;
+  size_t (*counts)[RADIX_BUCKETS] =
+      calloc(RADIX_PASSES, sizeof(size_t[RADIX_BUCKETS]));
+  if (!counts)
+    return false;
+
+  for (size_t i = 0; i < n; i++) {
+    unsigned long long k = keys[i];
+    for (int pass = 0; pass < RADIX_PASSES; pass++)
+      counts[pass][(k >> (pass * RADIX_BITS)) & digit_mask]++;
+  }
+
+  unsigned long long *src = keys, *dst = scratch;
+  for (int pass = 0; pass < RADIX_PASSES; pass++) {
+    size_t *count = counts[pass];
+    int shift = pass * RADIX_BITS;
+
+    // Chiffre constant sur tout le tableau: passe inutile
+    if (count[(src[0] >> shift) & digit_mask] == n) {
+      SortTick(0, 0, 1);
+      continue;
     }
-    if (!swapped)
+
+    size_t offset = 0;
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+      size_t c = count[b];
+      count[b] = offset;
+      offset += c;
+    }
+    for (size_t i = 0; i < n; i++) {
+      unsigned long long k = src[i];
+      dst[count[(k >> shift) & digit_mask]++] = k;
+    }
+
+    unsigned long long *temp = src;
+    src = dst;
+    dst = temp;
+
+    // Arrêt demandé: src contient toujours une permutation complète
+    if (SortTick(0, (long long)n, 1))
       break;
   }
+
+  if (src != keys)
+    memcpy(keys, src, n * sizeof(unsigned long long));
+  free(counts);
+  return true;
 }
 
-void InsertionSortString(char **arr, int n) {
-  for (int i = 1; i < n; i++) {
-    char *key = arr[i];
-    int j = i - 1;
-    while (j >= 0 && strcmp(arr[j], key) > 0) {
-      arr[j + 1] = arr[j];
-      j--;
-    }
-    arr[j + 1] = key;
+// Entiers signés: inverser le bit de signe donne l'ordre non signé
+void RadixSortInt(long long *arr, size_t n) {
+  if (n < 2)
+    return;
+  unsigned long long *scratch =
+      (unsigned long long *)PageAlloc(n * sizeof(unsigned long long));
+  bool sorted = scratch != NULL;
+
+  if (sorted) {
+    unsigned long long *keys = (unsigned long long *)arr;
+    for (size_t i = 0; i < n; i++)
+      keys[i] ^= RADIX_SIGN_BIT;
+    sorted = RadixSortKeys(keys, scratch, n);
+    for (size_t i = 0; i < n; i++)
+      keys[i] ^= RADIX_SIGN_BIT;
+    PageFree(scratch, n * sizeof(unsigned long long));
+  }
+
+  if (!sorted) {
+    SortNote("memoire insuffisante: introsort");
+    IntroSortInt(arr, n);
   }
 }
 
-void ShellSortString(char **arr, int n) {
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      char *temp = arr[i];
-      int j = i;
-      while (j >= gap && strcmp(arr[j - gap], temp) > 0) {
-        arr[j] = arr[j - gap];
-        j -= gap;
-      }
-      arr[j] = temp;
+// Doubles IEEE 754: négatifs => tous les bits inversés, positifs => bit de
+// signe mis à 1. L'ordre non signé des clés est alors l'ordre des réels.
+// Les clés sont calculées sur place, dans les octets des doubles.
+void RadixSortFloat(double *arr, size_t n) {
+  if (n < 2)
+    return;
+  unsigned long long *scratch =
+      (unsigned long long *)PageAlloc(n * sizeof(unsigned long long));
+  bool sorted = scratch != NULL;
+
+  if (sorted) {
+    unsigned long long *keys = (unsigned long long *)arr;
+    for (size_t i = 0; i < n; i++) {
+      unsigned long long u = keys[i];
+      keys[i] = (u & RADIX_SIGN_BIT) ? ~u : (u | RADIX_SIGN_BIT);
     }
+    sorted = RadixSortKeys(keys, scratch, n);
+    for (size_t i = 0; i < n; i++) {
+      unsigned long long u = keys[i];
+      keys[i] = (u & RADIX_SIGN_BIT) ? (u & ~RADIX_SIGN_BIT) : ~u;
+    }
+    PageFree(scratch, n * sizeof(unsigned long long));
+  }
+
+  if (!sorted) {
+    SortNote("memoire insuffisante: introsort");
+    IntroSortFloat(arr, n);
   }
 }
 
-static int PartitionString(char **arr, int low, int high) {
-  char *pivot = arr[high];
-  int i = low - 1;
-  for (int j = low; j < high; j++) {
-    if (strcmp(arr[j], pivot) <= 0) {
-      i++;
-      char *temp = arr[i];
-      arr[i] = arr[j];
-      arr[j] = temp;
+static void RunRadixInt(GenericData *data) {
+  RadixSortInt(data->data.int_data, data->size);
+}
+
+static void RunRadixFloat(GenericData *data) {
+  RadixSortFloat(data->data.float_data, data->size);
+}
+
+// ==================== TRI DE CHAÎNES (MULTIKEY) ====================
+
+// Quicksort multiclé (Bentley-Sedgewick) par mots de 8 octets: chaque
+// pointeur est rangé avec les 8 octets de sa chaîne à partir de la
+// profondeur courante, lus poids fort en tête pour que l'ordre des entiers
+// soit celui de strcmp. Les partitions ne lisent que ces clés contiguës;
+// les chaînes ne sont relues que pour le groupe des égaux, 8 octets plus
+// loin. Une clé dont l'octet de poids faible est nul contient la fin de
+// la chaîne: ses égaux sont des chaînes identiques.
+
+typedef struct {
+  unsigned long long key;
+  char *str;
+} MultikeyEntry;
+
+// 8 octets de s (zéros après le terminateur), sans lire au-delà
+static inline unsigned long long MultikeyLoad(const char *s) {
+  unsigned long long key = 0;
+  int i = 0;
+  for (; i < 8 && s[i]; i++)
+    key = (key << 8) | (unsigned char)s[i];
+  return i == 0 ? 0 : key << (8 * (8 - i));
+}
+
+// Ordre de deux entrées dont les depth premiers octets sont égaux
+static inline int MultikeyCompare(const MultikeyEntry *a,
+                                  const MultikeyEntry *b, size_t depth) {
+  if (a->key != b->key)
+    return a->key < b->key ? -1 : 1;
+  if ((a->key & 0xFF) == 0)
+    return 0;
+  return strcmp(a->str + depth + 8, b->str + depth + 8);
+}
+
+static inline void MultikeySwap(MultikeyEntry *a, MultikeyEntry *b) {
+  MultikeyEntry t = *a;
+  *a = *b;
+  *b = t;
+}
+
+static void MultikeyInsertion(MultikeyEntry *e, size_t n, size_t depth) {
+  for (size_t i = 1; i < n; i++) {
+    MultikeyEntry v = e[i];
+    ptrdiff_t j = (ptrdiff_t)i - 1;
+    while (j >= 0 && MultikeyCompare(&e[j], &v, depth) > 0) {
+      e[j + 1] = e[j];
+      j--;
     }
+    e[j + 1] = v;
   }
-  char *temp = arr[i + 1];
-  arr[i + 1] = arr[high];
-  arr[high] = temp;
-  return i + 1;
+  SortTick((long long)n, (long long)n, 0);
 }
 
-void QuickSortString(char **arr, int low, int high) {
-  if (low < high) {
-    int pi = PartitionString(arr, low, high);
-    QuickSortString(arr, low, pi - 1);
-    QuickSortString(arr, pi + 1, high);
+// Repli O(n log n) garanti pour un groupe dégénéré
+static void MultikeySift(MultikeyEntry *e, size_t root, size_t n,
+                         size_t depth) {
+  for (size_t child; (child = 2 * root + 1) < n; root = child) {
+    if (child + 1 < n && MultikeyCompare(&e[child], &e[child + 1], depth) < 0)
+      child++;
+    if (MultikeyCompare(&e[root], &e[child], depth) >= 0)
+      return;
+    MultikeySwap(&e[root], &e[child]);
   }
 }
 
-// ==================== ANCIENNES FONCTIONS TRI (COMPATIBILITÉ)
-// ====================
+static void MultikeyHeap(MultikeyEntry *e, size_t n, size_t depth) {
+  for (size_t i = n / 2; i-- > 0;)
+    MultikeySift(e, i, n, depth);
+  for (size_t end = n - 1; end > 0; end--) {
+    MultikeySwap(&e[0], &e[end]);
+    MultikeySift(e, 0, end, depth);
+  }
+  SortTick((long long)n * IntroDepthLimit(n), (long long)n, 1);
+}
 
-void BubbleSort(int *arr, int n) {
-  for (int i = 0; i < n - 1; i++) {
-    bool swapped = false;
-    for (int j = 0; j < n - i - 1; j++) {
-      if (arr[j] > arr[j + 1]) {
-        int temp = arr[j];
-        arr[j] = arr[j + 1];
-        arr[j + 1] = temp;
-        swapped = true;
+static void MultikeyRange(MultikeyEntry *e, size_t n, size_t depth,
+                          int budget) {
+  while (n > MULTIKEY_SMALL) {
+    if (SortTick(0, 0, 1))
+      return;
+    if (budget-- == 0) {
+      MultikeyHeap(e, n, depth);
+      return;
+    }
+
+    // Pivot: médiane des clés du début, du milieu et de la fin
+    unsigned long long a = e[0].key, b = e[n / 2].key, c = e[n - 1].key;
+    unsigned long long pivot =
+        a < b ? (b < c ? b : a < c ? c : a) : (a < c ? a : b < c ? c : b);
+
+    // Partition à trois voies: [0, lt) < pivot, [lt, gt) =, [gt, n) >
+    size_t lt = 0, i = 0, gt = n;
+    long long swaps = 0;
+    while (i < gt) {
+      if (e[i].key < pivot) {
+        MultikeySwap(&e[lt++], &e[i++]);
+        swaps++;
+      } else if (e[i].key > pivot) {
+        MultikeySwap(&e[i], &e[--gt]);
+        swaps++;
+      } else {
+        i++;
       }
     }
-    if (!swapped)
-      break;
+    if (SortTick((long long)n, swaps, 0))
+      return;
+
+    MultikeyRange(e, lt, depth, budget);
+    MultikeyRange(e + gt, n - gt, depth, budget);
+
+    // Égaux: même clé; chaînes terminées ou clés suivantes
+    e += lt;
+    n = gt - lt;
+    if ((pivot & 0xFF) == 0)
+      return;
+    depth += 8;
+    for (size_t k = 0; k < n; k++)
+      e[k].key = MultikeyLoad(e[k].str + depth);
+    SortTick(0, (long long)n, 0);
+    budget = IntroDepthLimit(n);
   }
+  MultikeyInsertion(e, n, depth);
 }
 
-void InsertionSort(int *arr, int n) {
-  for (int i = 1; i < n; i++) {
-    int key = arr[i];
-    int j = i - 1;
-    while (j >= 0 && arr[j] > key) {
-      arr[j + 1] = arr[j];
-      j--;
-    }
-    arr[j + 1] = key;
+void MultikeySortString(char **arr, size_t n) {
+  if (n < 2)
+    return;
+  MultikeyEntry *e = (MultikeyEntry *)PageAlloc(n * sizeof(MultikeyEntry));
+  if (!e) {
+    SortNote("memoire insuffisante: introsort");
+    IntroSortString(arr, n);
+    return;
   }
+
+  for (size_t i = 0; i < n; i++) {
+    e[i].key = MultikeyLoad(arr[i]);
+    e[i].str = arr[i];
+  }
+  SortTick(0, (long long)n, 1);
+  MultikeyRange(e, n, 0, IntroDepthLimit(n));
+
+  // Même interrompu, le tableau reste une permutation des pointeurs
+  for (size_t i = 0; i < n; i++)
+    arr[i] = e[i].str;
+  PageFree(e, n * sizeof(MultikeyEntry));
 }
 
-void ShellSort(int *arr, int n) {
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int i = gap; i < n; i++) {
-      int temp = arr[i];
-      int j = i;
-      while (j >= gap && arr[j - gap] > temp) {
-        arr[j] = arr[j - gap];
-        j -= gap;
-      }
-      arr[j] = temp;
+static void RunMultikeyString(GenericData *data) {
+  MultikeySortString(data->data.string_data, data->size);
+}
+
+// ==================== TRI PAR DÉNOMBREMENT ====================
+
+// Histogramme des clés puis réécriture dans l'ordre: O(n + k) pour une
+// plage de k valeurs. Accepté si k <= COUNTING_SMALL_RANGE, ou si k ne
+// dépasse ni COUNTING_RANGE_FACTOR * n ni COUNTING_MAX_RANGE; sinon
+// introsort. Les caractères (256 valeurs) sont toujours dénombrés.
+#define COUNTING_SMALL_RANGE (1 << 16)
+#define COUNTING_RANGE_FACTOR 2
+#define COUNTING_MAX_RANGE (1 << 24)
+#define COUNTING_CHAR_RANGE (UCHAR_MAX + 1)
+
+void CountingSortInt(long long *arr, size_t n) {
+  if (n < 2)
+    return;
+
+  // Un seul parcours pour la plage des clés
+  long long min = arr[0], max = arr[0];
+  for (size_t i = 1; i < n; i++) {
+    if (arr[i] < min)
+      min = arr[i];
+    else if (arr[i] > max)
+      max = arr[i];
+  }
+  SortTick((long long)n, 0, 1);
+
+  // Calcul non signé: max - min peut dépasser LLONG_MAX
+  unsigned long long span = (unsigned long long)max - (unsigned long long)min;
+  bool small = span < COUNTING_SMALL_RANGE ||
+               (span < COUNTING_MAX_RANGE &&
+                span < (unsigned long long)COUNTING_RANGE_FACTOR * n);
+  // Compteurs size_t: une valeur peut apparaître plus de INT_MAX fois
+  size_t *counts = small ? (size_t *)calloc(span + 1, sizeof(size_t)) : NULL;
+  if (!counts) {
+    SortNote(small ? "k=%.3g: memoire, introsort" : "k=%.3g > 2n: introsort",
+             (double)span + 1.0);
+    IntroSortInt(arr, n);
+    return;
+  }
+  SortNote("k=%llu: denombrement", span + 1);
+
+  for (size_t i = 0; i < n; i++) {
+    counts[arr[i] - min]++;
+    if ((i & SORT_TICK_MASK) == SORT_TICK_MASK &&
+        SortTick(SORT_TICK_MASK + 1, 0, 0)) {
+      free(counts);
+      return;
     }
   }
+  SortTick(0, 0, 1);
+
+  size_t out = 0;
+  for (unsigned long long v = 0; v <= span; v++) {
+    for (size_t c = counts[v]; c > 0; c--)
+      arr[out++] = min + (long long)v;
+  }
+  SortTick(0, (long long)n, 1);
+  free(counts);
 }
 
-static int Partition(int *arr, int low, int high) {
-  int pivot = arr[high];
-  int i = low - 1;
-  for (int j = low; j < high; j++) {
-    if (arr[j] <= pivot) {
-      i++;
-      int temp = arr[i];
-      arr[i] = arr[j];
-      arr[j] = temp;
-    }
+void CountingSortChar(char *arr, size_t n) {
+  if (n < 2)
+    return;
+
+  // Index = valeur - CHAR_MIN: l'ordre des seaux suit celui de char
+  size_t counts[COUNTING_CHAR_RANGE] = {0};
+  for (size_t i = 0; i < n; i++) {
+    counts[arr[i] - CHAR_MIN]++;
+    if ((i & SORT_TICK_MASK) == SORT_TICK_MASK &&
+        SortTick(SORT_TICK_MASK + 1, 0, 0))
+      return;
+  }
+  SortTick(0, 0, 1);
+
+  int distinct = 0;
+  size_t out = 0;
+  for (int v = 0; v < COUNTING_CHAR_RANGE; v++) {
+    distinct += (counts[v] > 0);
+    memset(arr + out, v + CHAR_MIN, counts[v]);
+    out += counts[v];
+  }
+  SortTick(0, (long long)n, 1);
+  SortNote("%d valeurs: denombrement", distinct);
+}
+
+static void RunCountingInt(GenericData *data) {
+  CountingSortInt(data->data.int_data, data->size);
+}
+
+static void RunCountingChar(GenericData *data) {
+  CountingSortChar(data->data.char_data, data->size);
+}
+
+// ==================== THREADS UTILITAIRES ====================
+
+// Exécute fn(index, ctx) pour index = 0..count-1, un thread par index
+// (l'index 0 tourne sur le thread appelant), puis attend la fin de tous.
+// Les threads auxiliaires publient dans le SortProgress du thread appelant.
+
+typedef struct {
+  ParallelFunc fn;
+  void *ctx;
+  int index;
+  SortProgress *progress;
+} ParallelTask;
+
+#ifdef _WIN32
+static DWORD WINAPI ParallelTrampoline(LPVOID arg) {
+  ParallelTask *task = (ParallelTask *)arg;
+  SortProgressAttach(task->progress);
+  task->fn(task->index, task->ctx);
+  SortProgressAttach(NULL);
+  return 0;
+}
+#else
+static void *ParallelTrampoline(void *arg) {
+  ParallelTask *task = (ParallelTask *)arg;
+  SortProgressAttach(task->progress);
+  task->fn(task->index, task->ctx);
+  SortProgressAttach(NULL);
+  return NULL;
+}
+#endif
+
+static void RunParallel(int count, ParallelFunc fn, void *ctx) {
+  if (count <= 1) {
+    fn(0, ctx);
+    return;
   }
-  int temp = arr[i + 1];
-  arr[i + 1] = arr[high];
-  arr[high] = temp;
-  return i + 1;
+
+  ParallelTask *tasks = (ParallelTask *)malloc(count * sizeof(ParallelTask));
+#ifdef _WIN32
+  HANDLE *handles = (HANDLE *)malloc(count * sizeof(HANDLE));
+#else
+  pthread_t *handles = (pthread_t *)malloc(count * sizeof(pthread_t));
+#endif
+  bool *started = (bool *)calloc(count, sizeof(bool));
+  if (!tasks || !handles || !started) {
+    // Pas de mémoire pour les threads: exécution séquentielle
+    for (int i = 0; i < count; i++)
+      fn(i, ctx);
+    free(tasks);
+    free(handles);
+    free(started);
+    return;
+  }
+
+  for (int i = 1; i < count; i++) {
+    tasks[i] = (ParallelTask){fn, ctx, i, tls_progress};
+#ifdef _WIN32
+    handles[i] = CreateThread(NULL, 0, ParallelTrampoline, &tasks[i], 0, NULL);
+    started[i] = handles[i] != NULL;
+#else
+    started[i] =
+        pthread_create(&handles[i], NULL, ParallelTrampoline, &tasks[i]) == 0;
+#endif
+    if (!started[i])
+      fn(i, ctx);
+  }
+
+  fn(0, ctx);
+
+  for (int i = 1; i < count; i++) {
+    if (!started[i])
+      continue;
+#ifdef _WIN32
+    WaitForSingleObject(handles[i], INFINITE);
+    CloseHandle(handles[i]);
+#else
+    pthread_join(handles[i], NULL);
+#endif
+  }
+
+  free(tasks);
+  free(handles);
+  free(started);
 }
 
-void QuickSort(int *arr, int low, int high) {
-  if (low < high) {
-    int pi = Partition(arr, low, high);
-    QuickSort(arr, low, pi - 1);
-    QuickSort(arr, pi + 1, high);
+static int g_sort_threads = 0; // 0 = nombre de cœurs
+
+int GetCpuCount(void) {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (int)info.dwNumberOfProcessors;
+#else
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (int)count : 1;
+#endif
+}
+
+void SetSortThreadCount(int threads) {
+  g_sort_threads = threads > 0 ? threads : 0;
+}
+
+int GetSortThreadCount(void) {
+  int threads = g_sort_threads > 0 ? g_sort_threads : GetCpuCount();
+  return threads > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : threads;
+}
+
+// ==================== TRI MULTI-CŒURS ====================
+
+// Tri fusion parallèle: le tableau est découpé en autant de blocs que de
+// threads, chaque bloc est trié (introsort) par un thread, puis les blocs
+// sont fusionnés deux à deux. À chaque tour, la fusion d'une paire est
+// elle-même découpée entre plusieurs threads (partage par co-rang), de sorte
+// que tous les cœurs travaillent jusqu'à la dernière fusion.
+
+typedef struct {
+  GenericData *data;
+  int threads;
+  size_t bounds[PARALLEL_MAX_THREADS + 1]; // Bornes des blocs triés
+  int runs;                                // Nombre de blocs courant
+  int width;                               // Blocs fusionnés par paire ce tour
+  void *src;
+  void *dst;
+} ParallelSortJob;
+
+static void ParallelSortChunk(int index, void *ctx) {
+  ParallelSortJob *job = (ParallelSortJob *)ctx;
+  TYPE_OPS[job->data->type].intro_block(GenericDataPointer(job->data),
+                                        job->bounds[index],
+                                        job->bounds[index + 1]);
+}
+
+static void ParallelMergeStep(int index, void *ctx) {
+  ParallelSortJob *job = (ParallelSortJob *)ctx;
+  int pairs = (job->runs + 1) / 2;
+  int parts = job->threads / pairs;
+  if (parts < 1)
+    parts = 1;
+
+  // Chaque thread traite une portion de la sortie d'une paire
+  for (int task = index; task < pairs * parts; task += job->threads) {
+    int pair = task / parts, part = task % parts;
+    int first = 2 * pair;
+    size_t a_lo = job->bounds[first];
+    size_t a_hi = job->bounds[first + 1];
+    size_t b_hi = (first + 2 <= job->runs) ? job->bounds[first + 2] : a_hi;
+
+    size_t total = b_hi - a_lo;
+    size_t k_begin = total * part / parts;
+    size_t k_end = total * (part + 1) / parts;
+
+    TYPE_OPS[job->data->type].merge_block(job->src, job->dst, a_lo, a_hi, b_hi,
+                                          k_begin, k_end);
+    SortTick((long long)(k_end - k_begin), (long long)(k_end - k_begin), 0);
   }
 }
 
+void ParallelSortGeneric(GenericData *data, int threads) {
+  if (!data || data->size < 2)
+    return;
+  if (threads <= 0)
+    threads = GetSortThreadCount();
+  if (threads > PARALLEL_MAX_THREADS)
+    threads = PARALLEL_MAX_THREADS;
+  // Pas la peine de découper en blocs plus petits que le seuil
+  while (threads > 1 && data->size / (size_t)threads < PARALLEL_MIN_CHUNK)
+    threads--;
+
+  size_t elem_size = GenericElementSize(data->type);
+  void *base = GenericDataPointer(data);
+  void *buffer = NULL;
+  if (threads > 1)
+    buffer = PageAlloc(data->size * elem_size);
+  if (!buffer)
+    threads = 1;
+
+  ParallelSortJob job;
+  job.data = data;
+  job.threads = threads;
+  job.runs = threads;
+  for (int i = 0; i <= threads; i++)
+    job.bounds[i] = data->size * i / threads;
+
+  RunParallel(threads, ParallelSortChunk, &job);
+
+  // Fusions successives: src = données, dst = tampon, puis échange. Un tour
+  // de fusion n'est jamais interrompu pour que src reste une permutation.
+  job.src = base;
+  job.dst = buffer;
+  while (job.runs > 1 && !SortStopRequested()) {
+    RunParallel(threads, ParallelMergeStep, &job);
+    SortTick(0, 0, 1);
+
+    int merged = 0;
+    for (int r = 0; r < job.runs; r += 2)
+      job.bounds[++merged] = job.bounds[(r + 2 <= job.runs) ? r + 2 : r + 1];
+    job.runs = merged;
+
+    void *temp = job.src;
+    job.src = job.dst;
+    job.dst = temp;
+  }
+
+  if (job.src != base)
+    memcpy(base, job.src, data->size * elem_size);
+  PageFree(buffer, data->size * elem_size);
+}
+
 // ==================== TRI GÉNÉRIQUE ====================
 
-double TimedSortGeneric(SortAlgorithm algo, GenericData *data) {
-  if (!data)
-    return 0;
+// Table de dispatch [type][algorithme]; NULL = algorithme non applicable
+typedef void (*SortKernel)(GenericData *data);
+
+static void RunParallelSort(GenericData *data) { ParallelSortGeneric(data, 0); }
+
+static void RunAutoSort(GenericData *data);
+
+#define SORT_TEMPLATE_KERNELS(S)                                              \
+  [SORT_BUBBLE] = RunBubble##S, [SORT_INSERTION] = RunInsertion##S,           \
+  [SORT_SHELL] = RunShell##S, [SORT_QUICK] = RunQuick##S,                     \
+  [SORT_INTRO] = RunIntro##S, [SORT_PARALLEL] = RunParallelSort,             \
+  [SORT_MERGE] = RunMerge##S, [SORT_TIM] = RunTim##S,                       \
+  [SORT_AUTO] = RunAutoSort
+
+static const SortKernel SORT_KERNELS[][SORT_COUNT] = {
+    [DATA_TYPE_INT] = {SORT_TEMPLATE_KERNELS(Int), [SORT_RADIX] = RunRadixInt,
+                       [SORT_COUNTING] = RunCountingInt,
+                       [SORT_EXTERNAL] = RunExternalInt},
+    [DATA_TYPE_FLOAT] = {SORT_TEMPLATE_KERNELS(Float),
+                         [SORT_RADIX] = RunRadixFloat,
+                         [SORT_EXTERNAL] = RunExternalFloat},
+    [DATA_TYPE_CHAR] = {SORT_TEMPLATE_KERNELS(Char),
+                        [SORT_COUNTING] = RunCountingChar,
+                        [SORT_EXTERNAL] = RunExternalChar},
+    [DATA_TYPE_STRING] = {SORT_TEMPLATE_KERNELS(String),
+                          [SORT_MULTIKEY] = RunMultikeyString},
+};
+
+bool SortSupportsType(SortAlgorithm algo, DataType type) {
+  return (unsigned)algo < SORT_COUNT && SORT_KERNELS[type][algo] != NULL;
+}
 
-  double start = GetHighResTime();
+bool SortIsStable(SortAlgorithm algo) {
+  switch (algo) {
+  case SORT_BUBBLE:
+  case SORT_INSERTION:
+  case SORT_RADIX:
+  case SORT_COUNTING:
+  case SORT_MERGE:
+  case SORT_TIM:
+    return true;
+  default:
+    return false;
+  }
+}
 
-  switch (data->type) {
+// ==================== TRI ADAPTATIF (SORT_AUTO) ====================
+
+// Un échantillon régulier de l'entrée donne la part de voisins croissants
+// et décroissants (suites naturelles), la part d'inversions entre éléments
+// échantillonnés, le nombre de valeurs distinctes, l'étendue des clés et,
+// pour les chaînes, l'entropie du premier caractère. Le noyau est choisi
+// par des règles fixes et des seuils de taille mesurés au démarrage.
+
+// Seuils avant calibration (ordre de grandeur d'une machine de bureau)
+static const AutoSortThresholds AUTO_DEFAULTS = {24, 4096, 1 << 17, 1 << 20,
+                                                 false};
+
+// La calibration tourne sur le thread du premier tri SORT_AUTO pendant que
+// d'autres tris lisent les seuils: g_auto n'est lu qu'une fois publié
+// (état 2), les défauts servent entre-temps
+static AutoSortThresholds g_auto;
+static volatile long g_auto_state = 0; // 0: à mesurer, 1: en cours, 2: prêt
+
+AutoSortThresholds GetAutoSortThresholds(void) {
+  return ATOMIC_LOAD(&g_auto_state) == 2 ? g_auto : AUTO_DEFAULTS;
+}
+
+typedef struct {
+  int samples;
+  double ascents;    // Part de voisins strictement croissants
+  double descents;   // Part de voisins strictement décroissants
+  double inversions; // Part de paires inversées de l'échantillon
+  int distinct;      // Valeurs distinctes de l'échantillon
+  double span;       // Étendue des clés échantillonnées (nombres)
+  double prefix_bits; // Entropie du premier caractère (chaînes)
+} AutoProfile;
+
+// Signe de la comparaison des éléments i et j
+static int AutoCompare(const GenericData *d, size_t i, size_t j) {
+  switch (d->type) {
   case DATA_TYPE_INT:
-    switch (algo) {
-    case SORT_BUBBLE:
-      BubbleSortInt(data->data.int_data, data->size);
-      break;
-    case SORT_INSERTION:
-      InsertionSortInt(data->data.int_data, data->size);
-      break;
-    case SORT_SHELL:
-      ShellSortInt(data->data.int_data, data->size);
-      break;
-    case SORT_QUICK:
-      QuickSortInt(data->data.int_data, 0, data->size - 1);
-      break;
-    default:
-      break;
-    }
-    break;
+    return (d->data.int_data[i] > d->data.int_data[j]) -
+           (d->data.int_data[i] < d->data.int_data[j]);
   case DATA_TYPE_FLOAT:
-    switch (algo) {
-    case SORT_BUBBLE:
-      BubbleSortFloat(data->data.float_data, data->size);
-      break;
-    case SORT_INSERTION:
-      InsertionSortFloat(data->data.float_data, data->size);
-      break;
-    case SORT_SHELL:
-      ShellSortFloat(data->data.float_data, data->size);
-      break;
-    case SORT_QUICK:
-      QuickSortFloat(data->data.float_data, 0, data->size - 1);
-      break;
-    default:
-      break;
-    }
-    break;
+    return (d->data.float_data[i] > d->data.float_data[j]) -
+           (d->data.float_data[i] < d->data.float_data[j]);
   case DATA_TYPE_CHAR:
-    switch (algo) {
-    case SORT_BUBBLE:
-      BubbleSortChar(data->data.char_data, data->size);
-      break;
-    case SORT_INSERTION:
-      InsertionSortChar(data->data.char_data, data->size);
-      break;
-    case SORT_SHELL:
-      ShellSortChar(data->data.char_data, data->size);
-      break;
-    case SORT_QUICK:
-      QuickSortChar(data->data.char_data, 0, data->size - 1);
-      break;
-    default:
-      break;
+    return (d->data.char_data[i] > d->data.char_data[j]) -
+           (d->data.char_data[i] < d->data.char_data[j]);
+  case DATA_TYPE_STRING: {
+    int c = strcmp(d->data.string_data[i], d->data.string_data[j]);
+    return (c > 0) - (c < 0);
+  }
+  }
+  return 0;
+}
+
+static double AutoKey(const GenericData *d, size_t i) {
+  switch (d->type) {
+  case DATA_TYPE_INT:
+    return (double)d->data.int_data[i];
+  case DATA_TYPE_FLOAT:
+    return d->data.float_data[i];
+  case DATA_TYPE_CHAR:
+    return (double)d->data.char_data[i];
+  default:
+    return 0;
+  }
+}
+
+// Profil de data (n >= 2) sur des positions régulières: sqrt(n), au plus
+// AUTO_SAMPLE, pour que les O(m^2) comparaisons restent négligeables
+static AutoProfile SampleProfile(const GenericData *d) {
+  AutoProfile p;
+  memset(&p, 0, sizeof(p));
+  size_t n = d->size;
+  int m = (int)sqrt((double)n);
+  m = m > AUTO_SAMPLE ? AUTO_SAMPLE : m < 2 ? 2 : m;
+  size_t idx[AUTO_SAMPLE];
+  for (int k = 0; k < m; k++)
+    idx[k] = (n - 1) * k / (m - 1);
+  p.samples = m;
+
+  // Suites: chaque position échantillonnée comparée à sa voisine
+  int up = 0, down = 0, pairs = 0;
+  for (int k = 0; k < m; k++) {
+    size_t i = idx[k] < n - 1 ? idx[k] : n - 2;
+    int c = AutoCompare(d, i, i + 1);
+    up += c < 0;
+    down += c > 0;
+    pairs++;
+  }
+  p.ascents = (double)up / pairs;
+  p.descents = (double)down / pairs;
+
+  // Inversions entre éléments de l'échantillon (0: trié, 1: inversé)
+  long long inv = 0, total = 0;
+  for (int a = 0; a < m; a++) {
+    for (int b = a + 1; b < m; b++) {
+      inv += AutoCompare(d, idx[a], idx[b]) > 0;
+      total++;
     }
-    break;
-  case DATA_TYPE_STRING:
-    switch (algo) {
-    case SORT_BUBBLE:
-      BubbleSortString(data->data.string_data, data->size);
-      break;
-    case SORT_INSERTION:
-      InsertionSortString(data->data.string_data, data->size);
-      break;
-    case SORT_SHELL:
-      ShellSortString(data->data.string_data, data->size);
-      break;
-    case SORT_QUICK:
-      QuickSortString(data->data.string_data, 0, data->size - 1);
-      break;
-    default:
+  }
+  p.inversions = total > 0 ? (double)inv / total : 0;
+
+  // Échantillon trié (insertion sur les positions): distinctes et étendue
+  for (int a = 1; a < m; a++) {
+    size_t v = idx[a];
+    int b = a - 1;
+    while (b >= 0 && AutoCompare(d, idx[b], v) > 0) {
+      idx[b + 1] = idx[b];
+      b--;
+    }
+    idx[b + 1] = v;
+  }
+  p.distinct = 1;
+  for (int a = 1; a < m; a++)
+    p.distinct += AutoCompare(d, idx[a - 1], idx[a]) != 0;
+  p.span = AutoKey(d, idx[m - 1]) - AutoKey(d, idx[0]);
+
+  if (d->type == DATA_TYPE_STRING) {
+    int counts[UCHAR_MAX + 1] = {0};
+    for (int k = 0; k < m; k++)
+      counts[(unsigned char)d->data.string_data[idx[k]][0]]++;
+    for (int c = 0; c <= UCHAR_MAX; c++) {
+      if (counts[c] > 0) {
+        double f = (double)counts[c] / m;
+        p.prefix_bits -= f * log2(f);
+      }
+    }
+  }
+  return p;
+}
+
+// Choix du noyau; reason reçoit la justification (note du tri)
+static SortAlgorithm ChooseAutoSort(const GenericData *d, char *reason,
+                                    size_t size) {
+  AutoSortThresholds th = GetAutoSortThresholds();
+  size_t n = d->size;
+  if (n <= th.insertion_max) {
+    snprintf(reason, size, "n<=%zu", th.insertion_max);
+    return SORT_INSERTION;
+  }
+
+  AutoProfile p = SampleProfile(d);
+  double breaks = p.ascents < p.descents ? p.ascents : p.descents;
+  if (breaks <= AUTO_RUN_BREAKS &&
+      (p.inversions <= 0.1 || p.inversions >= 0.9)) {
+    snprintf(reason, size, "suites, %.0f%% inv.", p.inversions * 100.0);
+    return SORT_TIM;
+  }
+
+  if (d->type == DATA_TYPE_CHAR) {
+    snprintf(reason, size, "char");
+    return SORT_COUNTING;
+  }
+  if (d->type == DATA_TYPE_INT &&
+      (p.distinct * 4 <= p.samples || p.span < 2.0 * n)) {
+    snprintf(reason, size, "%d val./%d ech.", p.distinct, p.samples);
+    return SORT_COUNTING;
+  }
+
+  bool numeric = d->type == DATA_TYPE_INT || d->type == DATA_TYPE_FLOAT;
+  int threads = GetSortThreadCount();
+  size_t parallel_min = numeric && n >= th.radix_min ? th.parallel_radix_min
+                                                     : th.parallel_min;
+  if (threads > 1 && n >= parallel_min) {
+    snprintf(reason, size, "n>=%zu, %d thr", parallel_min, threads);
+    return SORT_PARALLEL;
+  }
+  if (numeric && n >= th.radix_min) {
+    snprintf(reason, size, "n>=%zu", th.radix_min);
+    return SORT_RADIX;
+  }
+  // Chaînes: les clés de 8 octets évitent strcmp et ses défauts de cache,
+  // même quand les premiers caractères varient peu (entropie faible)
+  if (d->type == DATA_TYPE_STRING) {
+    snprintf(reason, size, "prefixe %.1f bits", p.prefix_bits);
+    return SORT_MULTIKEY;
+  }
+  snprintf(reason, size, "%.0f%% inv.", p.inversions * 100.0);
+  return SORT_INTRO;
+}
+
+static void RunAutoSort(GenericData *data) {
+  if (data->size < 2)
+    return;
+  char reason[SORT_NOTE_SIZE];
+  SortAlgorithm algo = ChooseAutoSort(data, reason, sizeof(reason));
+  SORT_KERNELS[data->type][algo](data);
+  // Note du noyau choisi remplacée par le choix et sa raison ("Radix Sort"
+  // abrégé en "Radix")
+  SortNote("%.*s: %s", (int)strcspn(SORT_NAMES[algo], " "), SORT_NAMES[algo],
+           reason);
+}
+
+// Temps de tri de batch tableaux de n entiers consécutifs de src
+static double CalibrationRun(SortAlgorithm algo, const long long *src,
+                             long long *work, size_t n, int batch) {
+  memcpy(work, src, n * batch * sizeof(long long));
+  double start = GetHighResTime();
+  for (int b = 0; b < batch; b++) {
+    GenericData slice;
+    memset(&slice, 0, sizeof(slice));
+    slice.type = DATA_TYPE_INT;
+    slice.size = n;
+    slice.data.int_data = work + b * n;
+    SORT_KERNELS[DATA_TYPE_INT][algo](&slice);
+  }
+  return GetHighResTime() - start;
+}
+
+// Meilleur temps de quelques essais
+static double CalibrationTime(SortAlgorithm algo, const long long *src,
+                              long long *work, size_t n, int batch) {
+  double best = HUGE_VAL;
+  for (int r = 0; r < AUTO_CALIBRATION_REPS; r++) {
+    double elapsed = CalibrationRun(algo, src, work, n, batch);
+    best = elapsed < best ? elapsed : best;
+  }
+  return best;
+}
+
+// Rapport des meilleurs temps de a et b, essais alternés: une perturbation
+// passagère (autre tri, fréquence) touche les deux noyaux
+static double CalibrationRatio(SortAlgorithm a, SortAlgorithm b,
+                               const long long *src, long long *work,
+                               size_t n, int batch) {
+  double best_a = HUGE_VAL, best_b = HUGE_VAL;
+  for (int r = 0; r < AUTO_CALIBRATION_REPS; r++) {
+    double ta = CalibrationRun(a, src, work, n, batch);
+    double tb = CalibrationRun(b, src, work, n, batch);
+    best_a = ta < best_a ? ta : best_a;
+    best_b = tb < best_b ? tb : best_b;
+  }
+  return best_a / best_b;
+}
+
+void CalibrateAutoSort(void) {
+  // Un seul thread mesure; les autres continuent avec les défauts
+  if (!ATOMIC_CAS(&g_auto_state, 0, 1))
+    return;
+  AutoSortThresholds th = AUTO_DEFAULTS;
+
+  int total = AUTO_CALIBRATION_BATCH > AUTO_LADDER_MAX ? AUTO_CALIBRATION_BATCH
+                                                       : AUTO_LADDER_MAX;
+  long long *src = GenerateRandomInts(total, 0, LLONG_MAX / 2, 0x5EEDULL);
+  size_t bytes = (size_t)total * sizeof(long long);
+  long long *work = (long long *)PageAlloc(bytes);
+  if (!src || !work) {
+    PageFree(src, bytes);
+    PageFree(work, bytes);
+    g_auto = th; // Seuils par défaut
+    ATOMIC_STORE(&g_auto_state, 2);
+    return;
+  }
+
+  // Jusqu'au seuil par défaut, l'insertion reste tant qu'elle ne perd pas
+  // nettement; au-delà, elle n'avance que si elle gagne nettement. 8
+  // éléments restent toujours à l'insertion.
+  static const size_t small[] = {8, 12, 16, 24, 32, 48, 64, 96, 128};
+  for (size_t i = 1; i < sizeof(small) / sizeof(small[0]); i++) {
+    int batch = (int)(AUTO_CALIBRATION_BATCH / small[i]);
+    // Temps d'insertion / temps d'introsort
+    double ratio = CalibrationRatio(SORT_INSERTION, SORT_INTRO, src, work,
+                                    small[i], batch);
+    if (small[i] <= AUTO_DEFAULTS.insertion_max) {
+      if (ratio > AUTO_CALIBRATION_MARGIN) {
+        th.insertion_max = small[i - 1];
+        break;
+      }
+    } else if (ratio * AUTO_CALIBRATION_MARGIN < 1.0) {
+      th.insertion_max = small[i];
+    } else {
       break;
     }
-    break;
   }
 
+  // Premier croisement de chaque noyau; sans croisement jusqu'à
+  // AUTO_LADDER_MAX, radix n'est jamais choisi et le parallèle est tenté
+  // au-delà (création des threads amortie sur de plus grands tableaux)
+  size_t radix_min = SIZE_MAX, parallel_min = 0, parallel_radix_min = 0;
+  bool threaded = GetSortThreadCount() > 1;
+  for (size_t n = 1024; n <= AUTO_LADDER_MAX; n *= 4) {
+    double intro = CalibrationTime(SORT_INTRO, src, work, n, 1);
+    double radix = CalibrationTime(SORT_RADIX, src, work, n, 1);
+    if (radix_min == SIZE_MAX && radix < intro)
+      radix_min = n;
+    if (!threaded)
+      continue;
+    double parallel = CalibrationTime(SORT_PARALLEL, src, work, n, 1);
+    if (!parallel_min && parallel < intro)
+      parallel_min = n;
+    if (!parallel_radix_min && parallel < radix)
+      parallel_radix_min = n;
+  }
+  th.radix_min = radix_min;
+  th.parallel_min =
+      !threaded ? SIZE_MAX : parallel_min ? parallel_min : AUTO_LADDER_MAX * 4;
+  th.parallel_radix_min = !threaded             ? SIZE_MAX
+                          : parallel_radix_min ? parallel_radix_min
+                                               : AUTO_LADDER_MAX * 4;
+  th.calibrated = true;
+
+  PageFree(src, bytes);
+  PageFree(work, bytes);
+  g_auto = th;
+  ATOMIC_STORE(&g_auto_state, 2);
+}
+
+double TimedSortGeneric(SortAlgorithm algo, GenericData *data) {
+  if (!data)
+    return 0;
+  if (!SortSupportsType(algo, data->type))
+    return -1;
+
+  // Premier SORT_AUTO: seuils mesurés sur ce thread, hors chronométrage et
+  // sans compter dans la progression du tri (ni répondre à son arrêt)
+  if (algo == SORT_AUTO && ATOMIC_LOAD(&g_auto_state) == 0) {
+    SortProgress *progress = tls_progress;
+    SortProgressAttach(NULL);
+    CalibrateAutoSort();
+    SortProgressAttach(progress);
+  }
+
+  tls_note[0] = '\0';
+  // Ouverture et lecture des compteurs hors de l'intervalle chronométré
+  HwCounterSession counters;
+  HwCountersStart(&counters);
+  double start = GetHighResTime();
+  SORT_KERNELS[data->type][algo](data);
   double end = GetHighResTime();
+  HwCountersStop(&counters, &tls_counters);
   return end - start;
 }
 
-double TimedSort(SortAlgorithm algo, int *data_copy, int size) {
-  clock_t start = clock();
+double TimedSortTracked(SortAlgorithm algo, GenericData *data,
+                        SortProgress *progress) {
+  SortProgressAttach(progress);
+  double elapsed = TimedSortGeneric(algo, data);
+  SortProgressAttach(NULL);
+  return elapsed;
+}
+
+double TimedSort(SortAlgorithm algo, int *data_copy, size_t size) {
+  double start = GetHighResTime();
 
   switch (algo) {
   case SORT_BUBBLE:
@@ -680,149 +2361,512 @@ double TimedSort(SortAlgorithm algo, int *data_copy, int size) {
     ShellSort(data_copy, size);
     break;
   case SORT_QUICK:
-    QuickSort(data_copy, 0, size - 1);
+    QuickSort(data_copy, 0, (ptrdiff_t)size - 1);
     break;
   default:
     break;
   }
 
-  clock_t end = clock();
-  return (double)(end - start) / CLOCKS_PER_SEC;
+  return GetHighResTime() - start;
 }
 
 // ==================== VÉRIFICATION TRI ====================
 
+// Le tableau est découpé en un bloc contigu par thread; chaque bloc vérifie
+// aussi la paire qui le relie au bloc suivant. Les empreintes partielles
+// s'additionnent (la somme ne dépend pas du découpage).
+
+const char *SORT_VERIFY_NAMES[] = {"OK", "NON TRIE", "ELEMENTS MODIFIES"};
+
+// Taille minimale d'un bloc: en dessous, créer un thread coûte plus que lire
+#define VERIFY_MIN_CHUNK (1 << 18)
+
+typedef struct {
+  const GenericData *data;
+  int threads;
+  bool check_order;
+  bool want_sum;
+  bool ordered[PARALLEL_MAX_THREADS];
+  unsigned long long sum[PARALLEL_MAX_THREADS];
+} VerifyJob;
+
+static void VerifyWorker(int index, void *ctx) {
+  VerifyJob *job = (VerifyJob *)ctx;
+  size_t n = job->data->size;
+  size_t lo = n * index / job->threads;
+  size_t hi = n * (index + 1) / job->threads;
+  job->sum[index] = 0;
+  job->ordered[index] = TYPE_OPS[job->data->type].verify(
+      GenericDataPointer((GenericData *)job->data), lo, hi, n,
+      job->check_order, job->want_sum ? &job->sum[index] : NULL);
+}
+
+// Ordre (si check_order) et empreinte (si sum) en une passe parallèle
+static bool RunVerify(const GenericData *data, bool check_order,
+                      unsigned long long *sum) {
+  VerifyJob job;
+  job.data = data;
+  job.check_order = check_order;
+  job.want_sum = sum != NULL;
+  job.threads = GetSortThreadCount();
+  if ((size_t)job.threads > data->size / VERIFY_MIN_CHUNK)
+    job.threads = (int)(data->size / VERIFY_MIN_CHUNK);
+  if (job.threads < 1)
+    job.threads = 1;
+  RunParallel(job.threads, VerifyWorker, &job);
+
+  bool ordered = true;
+  unsigned long long total = 0;
+  for (int i = 0; i < job.threads; i++) {
+    ordered = ordered && job.ordered[i];
+    total += job.sum[i];
+  }
+  if (sum)
+    *sum = total;
+  return ordered;
+}
+
 bool IsSortedGeneric(const GenericData *data) {
   if (!data || data->size <= 1)
     return true;
+  return RunVerify(data, true, NULL);
+}
 
-  switch (data->type) {
-  case DATA_TYPE_INT:
-    for (int i = 0; i < data->size - 1; i++) {
-      if (data->data.int_data[i] > data->data.int_data[i + 1])
-        return false;
-    }
-    break;
-  case DATA_TYPE_FLOAT:
-    for (int i = 0; i < data->size - 1; i++) {
-      if (data->data.float_data[i] > data->data.float_data[i + 1])
-        return false;
-    }
-    break;
-  case DATA_TYPE_CHAR:
-    for (int i = 0; i < data->size - 1; i++) {
-      if (data->data.char_data[i] > data->data.char_data[i + 1])
-        return false;
-    }
-    break;
-  case DATA_TYPE_STRING:
-    for (int i = 0; i < data->size - 1; i++) {
-      if (strcmp(data->data.string_data[i], data->data.string_data[i + 1]) > 0)
-        return false;
-    }
-    break;
-  }
-  return true;
+unsigned long long GenericDataChecksum(const GenericData *data) {
+  unsigned long long sum = 0;
+  if (data && data->size > 0 && GenericDataPointer((GenericData *)data))
+    RunVerify(data, false, &sum);
+  return sum;
 }
 
-bool IsSorted(const int *arr, int n) {
-  for (int i = 0; i < n - 1; i++) {
-    if (arr[i] > arr[i + 1])
-      return false;
-  }
-  return true;
+void UpdateGenericDataChecksum(GenericData *data) {
+  if (!data)
+    return;
+  data->checksum = GenericDataChecksum(data);
+  data->has_checksum = true;
 }
 
+SortVerify VerifySortedGeneric(const GenericData *sorted,
+                               const GenericData *original) {
+  if (!sorted)
+    return SORT_VERIFY_CORRUPTED;
+  if (original &&
+      (original->type != sorted->type || original->size != sorted->size))
+    return SORT_VERIFY_CORRUPTED;
+
+  unsigned long long sum = 0;
+  if (sorted->size > 0 && !RunVerify(sorted, true, original ? &sum : NULL))
+    return SORT_VERIFY_UNSORTED;
+  if (!original)
+    return SORT_VERIFY_OK;
+
+  unsigned long long expected = original->has_checksum
+                                    ? original->checksum
+                                    : GenericDataChecksum(original);
+  return sum == expected ? SORT_VERIFY_OK : SORT_VERIFY_CORRUPTED;
+}
+
+bool IsSorted(const int *arr, size_t n) { return IsSortedRange(arr, n); }
+
 // ==================== TRI PARALLÈLE ====================
 
 typedef struct {
   SortThread *st;
 } ThreadArg;
 
-#ifdef _WIN32
-static DWORD WINAPI SortThreadFunc(LPVOID arg) {
-  SortThread *st = (SortThread *)arg;
-  st->running = true;
-  st->completed = false;
+// Le noyau publie sa progression dans st->progress; la lecture des
+// compteurs par l'UI se fait sans verrou (valeurs atomiques).
+static void RunSortThread(SortThread *st) {
+  // Recopie de l'original dans le tampon du tri, hors mesure du temps
+  if (st->source)
+    ATOMIC_STORE(&st->data, CopyGenericDataInto(st->data, st->source));
 
-  double start = GetHighResTime();
-  TimedSortGeneric(st->algo, st->data);
-  double end = GetHighResTime();
+  SortProgressAttach(&st->progress);
+
+  double sort_time = TimedSortGeneric(st->algo, st->data);
+  bool stopped = SortStopRequested();
+
+  SortProgressAttach(NULL);
+  snprintf(st->note, sizeof(st->note), "%s", SortLastNote());
+  st->counters = SortLastCounters();
 
-  st->elapsed_time = end - start;
+  // Vérification hors mesure: ordre et mêmes éléments que l'original
+  if (!stopped && sort_time >= 0) {
+    st->verify = VerifySortedGeneric(st->data, st->source);
+    if (st->verify != SORT_VERIFY_OK)
+      snprintf(st->note, sizeof(st->note), "ECHEC: %s",
+               SORT_VERIFY_NAMES[st->verify]);
+  }
+
+  // Temps négatif: algorithme non applicable à ce type
+  st->elapsed_time = sort_time;
   st->running = false;
-  st->completed = true;
+  // Un tri interrompu n'est pas marqué terminé
+  ATOMIC_STORE(&st->completed, !stopped);
+}
 
+// Tri non affiché: son tampon ne survit pas au thread
+static void ReleaseThreadData(SortThread *st) {
+  if (!st->release_data)
+    return;
+  GenericData *data = st->data;
+  ATOMIC_STORE(&st->data, NULL);
+  FreeGenericData(data);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI SortThreadFunc(LPVOID arg) {
+  RunSortThread((SortThread *)arg);
+  ReleaseThreadData((SortThread *)arg);
   return 0;
 }
 #else
 static void *SortThreadFunc(void *arg) {
-  SortThread *st = (SortThread *)arg;
-  st->running = true;
-  st->completed = false;
-
-  double start = GetHighResTime();
-  TimedSortGeneric(st->algo, st->data);
-  double end = GetHighResTime();
-
-  st->elapsed_time = end - start;
-  st->running = false;
-  st->completed = true;
-
+  RunSortThread((SortThread *)arg);
+  ReleaseThreadData((SortThread *)arg);
   return NULL;
 }
 #endif
 
 void StartSortThread(SortThread *st, SortAlgorithm algo, GenericData *data) {
+  // Un thread précédent (terminé) doit être rejoint avant réutilisation
+  WaitSortThread(st);
+
   st->algo = algo;
-  st->data = CopyGenericData(data); // Copie pour ce thread
+  st->source = data; // Recopié dans st->data par le thread
   st->elapsed_time = 0;
-  st->running = false;
+  st->running = true;
   st->completed = false;
-  st->should_stop = false;
+  st->note[0] = '\0';
+  st->verify = SORT_VERIFY_OK;
+  HwCountersClear(&st->counters);
+  memset(&st->progress, 0, sizeof(st->progress));
 
 #ifdef _WIN32
   st->thread = CreateThread(NULL, 0, SortThreadFunc, st, 0, NULL);
 #else
-  pthread_create(&st->thread, NULL, SortThreadFunc, st);
+  pthread_t tid;
+  if (pthread_create(&tid, NULL, SortThreadFunc, st) == 0)
+    st->thread = (void *)(uintptr_t)tid;
+  else
+    st->thread = NULL;
 #endif
+  if (!st->thread) { // Pas de thread: tri exécuté sur place
+    RunSortThread(st);
+    ReleaseThreadData(st);
+  }
 }
 
 void WaitSortThread(SortThread *st) {
+  if (!st->thread)
+    return;
 #ifdef _WIN32
-  if (st->thread) {
-    WaitForSingleObject(st->thread, INFINITE);
-    CloseHandle(st->thread);
-    st->thread = NULL;
-  }
+  WaitForSingleObject(st->thread, INFINITE);
+  CloseHandle(st->thread);
 #else
-  pthread_join(st->thread, NULL);
+  pthread_join((pthread_t)(uintptr_t)st->thread, NULL);
 #endif
+  st->thread = NULL;
 }
 
 void StopSortThread(SortThread *st) {
-  st->should_stop = true;
+  // Arrêt coopératif: le noyau relit should_stop à chaque publication et
+  // rend la main en laissant les données dans un état valide
+  ATOMIC_STORE(&st->progress.should_stop, 1);
+  WaitSortThread(st);
+  FreeGenericData(st->data);
+  st->data = NULL;
+  st->running = false;
+}
+
+// Coefficients mesurés sur données aléatoires (entiers et réels)
+double ExpectedSortWork(SortAlgorithm algo, size_t n) {
+  double dn = n > 1 ? (double)n : 2;
+  double nlogn = dn * log2(dn);
+  switch (algo) {
+  case SORT_BUBBLE:
+    return 0.75 * dn * dn; // n²/2 comparaisons + ~n²/4 échanges
+  case SORT_INSERTION:
+    return 0.5 * dn * dn; // ~n²/4 comparaisons + ~n²/4 déplacements
+  case SORT_SHELL:
+    return 4.2 * pow(dn, 1.25);
+  case SORT_QUICK:
+    return 1.85 * nlogn;
+  case SORT_PARALLEL: {
+    // Introsort sur n/T éléments par bloc, puis log2(T) tours de fusion
+    int threads = GetSortThreadCount();
+    while (threads > 1 && n / (size_t)threads < PARALLEL_MIN_CHUNK)
+      threads--;
+    return 1.4 * dn * log2(dn / threads) + 2.0 * dn * log2(threads);
+  }
+  case SORT_COUNTING:
+    return 3.0 * dn; // Plage + histogramme + réécriture
+  case SORT_MERGE:
+  case SORT_TIM:
+    return 2.0 * nlogn; // Une comparaison + une copie par élément et passe
+  case SORT_EXTERNAL: {
+    // Introsort par suite, écriture + relecture, puis fusion par tas
+    double run = (double)ExternalRunLength(sizeof(long long));
+    if (run > dn)
+      run = dn;
+    double runs = ceil(dn / run);
+    return 1.4 * dn * log2(run) + 2.0 * dn + 2.0 * dn * log2(runs);
+  }
+  default:
+    return 1.4 * nlogn;
+  }
+}
+
+float SortThreadProgress(const SortThread *st) {
+  if (ATOMIC_LOAD(&st->completed))
+    return 1.0f;
+  // Taille lue sur l'original, fixe pendant le tri: le worker peut libérer
+  // st->data et le remplacer (CopyGenericDataInto) pendant cette lecture
+  const GenericData *data = st->source ? st->source : ATOMIC_LOAD(&st->data);
+  if (!data)
+    return 0.0f;
+  double progress;
+  if (st->algo == SORT_RADIX) {
+    // Une passe par chiffre, passes sautées comprises
+    progress = (double)ATOMIC_LOAD(&st->progress.passes) / RADIX_PASSES;
+  } else {
+    double done = (double)ATOMIC_LOAD(&st->progress.comparisons) +
+                  (double)ATOMIC_LOAD(&st->progress.moves);
+    progress = done / ExpectedSortWork(st->algo, data->size);
+  }
+  // L'estimation peut être dépassée: 1.0 est réservé aux tris terminés
+  return progress > 0.99 ? 0.99f : (float)progress;
+}
+
+// ==================== POOL DE THREADS ====================
+
+// Workers persistants: les tris soumis forment une file chaînée
+// (SortThread.next) protégée par un verrou. pending repasse à false sous ce
+// verrou quand le worker n'utilise plus le SortThread, qui peut alors être
+// réutilisé ou libéré. Les tampons rendus (release_data) attendent dans
+// spare le tri suivant: il y en a au plus un par worker.
+#define SORT_POOL_MAX_WORKERS 64
+
+struct SortPool {
 #ifdef _WIN32
-  if (st->thread) {
-    TerminateThread(st->thread, 0);
-    CloseHandle(st->thread);
-    st->thread = NULL;
+  CRITICAL_SECTION lock;
+  CONDITION_VARIABLE work_ready;
+  CONDITION_VARIABLE job_done;
+  HANDLE workers[SORT_POOL_MAX_WORKERS];
+#else
+  pthread_mutex_t lock;
+  pthread_cond_t work_ready;
+  pthread_cond_t job_done;
+  pthread_t workers[SORT_POOL_MAX_WORKERS];
+#endif
+  int worker_count;
+  GenericData *spare[SORT_POOL_MAX_WORKERS];
+  int spare_count;
+  SortThread *head;
+  SortThread *tail;
+  bool shutdown;
+};
+
+#ifdef _WIN32
+#define POOL_LOCK(pool) EnterCriticalSection(&(pool)->lock)
+#define POOL_UNLOCK(pool) LeaveCriticalSection(&(pool)->lock)
+#define POOL_WAIT(pool, cond)                                                  \
+  SleepConditionVariableCS(&(pool)->cond, &(pool)->lock, INFINITE)
+#define POOL_SIGNAL(pool, cond) WakeConditionVariable(&(pool)->cond)
+#define POOL_BROADCAST(pool, cond) WakeAllConditionVariable(&(pool)->cond)
+#else
+#define POOL_LOCK(pool) pthread_mutex_lock(&(pool)->lock)
+#define POOL_UNLOCK(pool) pthread_mutex_unlock(&(pool)->lock)
+#define POOL_WAIT(pool, cond) pthread_cond_wait(&(pool)->cond, &(pool)->lock)
+#define POOL_SIGNAL(pool, cond) pthread_cond_signal(&(pool)->cond)
+#define POOL_BROADCAST(pool, cond) pthread_cond_broadcast(&(pool)->cond)
+#endif
+
+static void SortPoolWorker(SortPool *pool) {
+  POOL_LOCK(pool);
+  for (;;) {
+    while (!pool->head && !pool->shutdown)
+      POOL_WAIT(pool, work_ready);
+    if (!pool->head) // Arrêt demandé et file vide
+      break;
+
+    SortThread *st = pool->head;
+    pool->head = st->next;
+    if (!pool->head)
+      pool->tail = NULL;
+    // Tampon d'un tri déjà fini, recouvert par la copie de l'original
+    if (!st->data && pool->spare_count > 0)
+      ATOMIC_STORE(&st->data, pool->spare[--pool->spare_count]);
+    POOL_UNLOCK(pool);
+
+    // Tri annulé avant d'avoir démarré
+    if (ATOMIC_LOAD(&st->progress.should_stop))
+      st->running = false;
+    else
+      RunSortThread(st);
+
+    POOL_LOCK(pool);
+    if (st->release_data && st->data) {
+      GenericData *data = st->data;
+      ATOMIC_STORE(&st->data, NULL);
+      if (pool->spare_count < pool->worker_count)
+        pool->spare[pool->spare_count++] = data;
+      else
+        FreeGenericData(data);
+    }
+    st->pending = false;
+    POOL_BROADCAST(pool, job_done);
   }
+  POOL_UNLOCK(pool);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI SortPoolThreadFunc(LPVOID arg) {
+  SortPoolWorker((SortPool *)arg);
+  return 0;
+}
 #else
-  pthread_cancel(st->thread);
+static void *SortPoolThreadFunc(void *arg) {
+  SortPoolWorker((SortPool *)arg);
+  return NULL;
+}
 #endif
-  st->running = false;
+
+SortPool *CreateSortPool(int workers) {
+  if (workers <= 0)
+    workers = SORT_COUNT;
+  if (workers > SORT_POOL_MAX_WORKERS)
+    workers = SORT_POOL_MAX_WORKERS;
+
+  SortPool *pool = (SortPool *)calloc(1, sizeof(SortPool));
+  if (!pool)
+    return NULL;
+
+#ifdef _WIN32
+  InitializeCriticalSection(&pool->lock);
+  InitializeConditionVariable(&pool->work_ready);
+  InitializeConditionVariable(&pool->job_done);
+#else
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work_ready, NULL);
+  pthread_cond_init(&pool->job_done, NULL);
+#endif
+
+  for (int i = 0; i < workers; i++) {
+#ifdef _WIN32
+    pool->workers[i] =
+        CreateThread(NULL, 0, SortPoolThreadFunc, pool, 0, NULL);
+    if (!pool->workers[i])
+      break;
+#else
+    if (pthread_create(&pool->workers[i], NULL, SortPoolThreadFunc, pool) != 0)
+      break;
+#endif
+    pool->worker_count++;
+  }
+
+  // Aucun worker: l'appelant revient aux threads créés à la demande
+  if (pool->worker_count == 0) {
+    DestroySortPool(pool);
+    return NULL;
+  }
+  return pool;
 }
 
-void StartAllSorts(SortManager *manager, GenericData *original) {
-  manager->original = original;
+// Libère les tampons en attente d'un tri
+static void TrimSortPool(SortPool *pool) {
+  POOL_LOCK(pool);
+  while (pool->spare_count > 0)
+    FreeGenericData(pool->spare[--pool->spare_count]);
+  POOL_UNLOCK(pool);
+}
 
-  for (int i = 0; i < SORT_COUNT; i++) {
-    manager->completed[i] = false;
-    manager->running[i] = true;
-    manager->times[i] = 0;
-    StartSortThread(&manager->threads[i], (SortAlgorithm)i, original);
+void DestroySortPool(SortPool *pool) {
+  if (!pool)
+    return;
+
+  POOL_LOCK(pool);
+  pool->shutdown = true;
+  POOL_BROADCAST(pool, work_ready);
+  POOL_UNLOCK(pool);
+
+  for (int i = 0; i < pool->worker_count; i++) {
+#ifdef _WIN32
+    WaitForSingleObject(pool->workers[i], INFINITE);
+    CloseHandle(pool->workers[i]);
+#else
+    pthread_join(pool->workers[i], NULL);
+#endif
   }
+
+  TrimSortPool(pool);
+#ifdef _WIN32
+  DeleteCriticalSection(&pool->lock);
+#else
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->work_ready);
+  pthread_cond_destroy(&pool->job_done);
+#endif
+  free(pool);
+}
+
+void SubmitSortJob(SortPool *pool, SortThread *st, SortAlgorithm algo,
+                   const GenericData *data) {
+  // Le SortThread ne doit plus être utilisé par un worker
+  WaitSortJob(pool, st);
+
+  st->algo = algo;
+  st->source = data; // Recopié dans st->data par le worker
+  st->elapsed_time = 0;
+  st->running = true;
+  st->completed = false;
+  st->note[0] = '\0';
+  st->verify = SORT_VERIFY_OK;
+  HwCountersClear(&st->counters);
+  memset(&st->progress, 0, sizeof(st->progress));
+  st->next = NULL;
+
+  POOL_LOCK(pool);
+  st->pending = true;
+  if (pool->tail)
+    pool->tail->next = st;
+  else
+    pool->head = st;
+  pool->tail = st;
+  POOL_SIGNAL(pool, work_ready);
+  POOL_UNLOCK(pool);
+}
+
+void WaitSortJob(SortPool *pool, SortThread *st) {
+  POOL_LOCK(pool);
+  while (st->pending)
+    POOL_WAIT(pool, job_done);
+  POOL_UNLOCK(pool);
+}
+
+void StartSort(SortManager *manager, GenericData *original,
+               SortAlgorithm algo) {
+  SortThread *st = &manager->threads[algo];
+  // Le tri précédent lit encore release_data jusqu'à sa fin
+  if (manager->pool)
+    WaitSortJob(manager->pool, st);
+  else
+    WaitSortThread(st);
+  st->release_data = manager->kept_sort >= 0 && manager->kept_sort != (int)algo;
+
+  manager->original = original;
+  manager->completed[algo] = false;
+  manager->running[algo] = true;
+  manager->times[algo] = 0;
+  if (manager->pool)
+    SubmitSortJob(manager->pool, st, algo, original);
+  else
+    StartSortThread(st, algo, original);
+}
+
+void StartAllSorts(SortManager *manager, GenericData *original) {
+  for (int i = 0; i < SORT_COUNT; i++)
+    StartSort(manager, original, (SortAlgorithm)i);
 }
 
 bool AllSortsCompleted(SortManager *manager) {
@@ -840,10 +2884,51 @@ bool AllSortsCompleted(SortManager *manager) {
 }
 
 void StopAllSorts(SortManager *manager) {
+  // Signaler l'arrêt à tous les tris avant d'attendre le premier
   for (int i = 0; i < SORT_COUNT; i++) {
+    if (manager->running[i])
+      ATOMIC_STORE(&manager->threads[i].progress.should_stop, 1);
+  }
+
+  for (int i = 0; i < SORT_COUNT; i++) {
+    SortThread *st = &manager->threads[i];
     if (manager->running[i]) {
-      StopSortThread(&manager->threads[i]);
+      if (manager->pool)
+        WaitSortJob(manager->pool, st);
+      else
+        WaitSortThread(st);
+      st->running = false;
     }
     manager->running[i] = false;
   }
 }
+
+void ReleaseSortBuffers(SortManager *manager) {
+  for (int i = 0; i < SORT_COUNT; i++) {
+    if (manager->sorted[i] == manager->threads[i].data)
+      manager->sorted[i] = NULL;
+    FreeGenericData(manager->threads[i].data);
+    manager->threads[i].data = NULL;
+  }
+  if (manager->pool)
+    TrimSortPool(manager->pool);
+}
+
+void TrimSortBuffers(SortManager *manager) {
+  for (int i = 0; i < SORT_COUNT; i++) {
+    SortThread *st = &manager->threads[i];
+    // Un worker peut encore rendre le tampon d'un tri fini
+    if (manager->pool)
+      WaitSortJob(manager->pool, st);
+    else
+      WaitSortThread(st);
+    if (manager->kept_sort < 0 || i == manager->kept_sort)
+      continue;
+    if (manager->sorted[i] == st->data)
+      manager->sorted[i] = NULL;
+    FreeGenericData(st->data);
+    st->data = NULL;
+  }
+  if (manager->pool)
+    TrimSortPool(manager->pool);
+}
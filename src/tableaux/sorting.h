@@ -5,7 +5,9 @@
 #ifndef SORTING_H
 #define SORTING_H
 
+#include "hwcounters.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 // Note: Ne pas inclure windows.h ici pour éviter les conflits avec Raylib
 // Les handles de threads sont gérés avec void* et castés dans sorting.c
@@ -19,6 +21,21 @@ typedef enum {
   DATA_TYPE_STRING
 } DataType;
 
+// Distribution des données générées (benchmarks sur entrées réalistes)
+typedef enum {
+  DIST_UNIFORM,       // Aléatoire uniforme
+  DIST_SORTED,        // Déjà trié
+  DIST_REVERSED,      // Trié à l'envers
+  DIST_NEARLY_SORTED, // Trié avec ~1% d'éléments échangés
+  DIST_FEW_UNIQUE,    // 16 valeurs distinctes
+  DIST_ORGAN_PIPE,    // Croissant puis décroissant
+  DIST_ZIPF,          // Doublons de fréquence ~ 1/rang (1000 valeurs)
+  DIST_COUNT
+} DataDistribution;
+
+// Noms des distributions
+extern const char *DIST_NAMES[DIST_COUNT];
+
 // ==================== ALGORITHMES DE TRI ====================
 
 typedef enum {
@@ -26,6 +43,15 @@ typedef enum {
   SORT_INSERTION,
   SORT_SHELL,
   SORT_QUICK,
+  SORT_INTRO, // Introsort: quicksort + heapsort/insertion (pire cas O(n log n))
+  SORT_RADIX, // Tri par base LSD (entiers et réels uniquement)
+  SORT_PARALLEL, // Tri fusion multi-threads (blocs introsort + fusions)
+  SORT_COUNTING, // Dénombrement (char, entiers à plage réduite, sinon intro)
+  SORT_MERGE,    // Tri fusion ascendant (stable, tampon unique)
+  SORT_TIM,      // TimSort: suites naturelles + galop (stable)
+  SORT_EXTERNAL, // Tri externe: suites sur disque + fusion k voies
+  SORT_MULTIKEY, // Quicksort multiclé (chaînes): préfixes de 8 octets en cache
+  SORT_AUTO,     // Choix adaptatif: échantillon + seuils calibrés
   SORT_COUNT
 } SortAlgorithm;
 
@@ -34,27 +60,77 @@ typedef enum {
 // Structure pour stocker des données de différents types
 typedef struct {
   DataType type;
-  int size;
+  size_t size;
+  unsigned long long seed; // Graine de génération (reproductibilité)
+  DataDistribution dist;   // Distribution de génération
+  // Empreinte du contenu indépendante de l'ordre (GenericDataChecksum),
+  // calculée à la génération et recopiée avec les données. Fausse pour un
+  // fichier projeté ou une saisie tant que UpdateGenericDataChecksum n'a
+  // pas été appelée.
+  bool has_checksum;
+  unsigned long long checksum;
   union {
     long long *int_data; // Entiers (millions/milliards)
     double *float_data;  // Réels
     char *char_data;     // Caractères
-    char **string_data;  // Chaînes
+    char **string_data;  // Chaînes (pointeurs dans string_arena)
   } data;
+  // Chaînes: tous les caractères (terminateurs compris) dans un seul bloc;
+  // les tris ne déplacent que les pointeurs de string_data. NULL si les
+  // pointeurs désignent le bloc d'une autre structure (non possédé).
+  char *string_arena;
+  size_t arena_size;
+  // Projection du fichier d'origine (LoadDataset, dataset.h), NULL si les
+  // tableaux sont alloués (PageAlloc, pagealloc.h): données et bloc de
+  // chaînes pointent alors dedans
+  void *mapping;
+  size_t mapping_size;
 } GenericData;
 
 // ==================== STRUCTURE POUR TRI PARALLÈLE ====================
 
+// Compteurs publiés par les noyaux de tri pendant l'exécution (lus par l'UI)
+// et demande d'arrêt coopératif (écrite par l'UI, relue par les noyaux)
 typedef struct {
+  volatile int should_stop;
+  volatile long long comparisons;
+  volatile long long moves;
+  volatile long long passes; // Passes / partitions / fusions terminées
+} SortProgress;
+
+// Résultat de VerifySortedGeneric
+typedef enum {
+  SORT_VERIFY_OK,
+  SORT_VERIFY_UNSORTED, // Deux éléments voisins inversés
+  SORT_VERIFY_CORRUPTED // Éléments perdus, dupliqués ou modifiés
+} SortVerify;
+
+// Libellés courts (UI, notes), dans l'ordre de SortVerify
+extern const char *SORT_VERIFY_NAMES[];
+
+// Taille des notes laissées par les algorithmes (voir SortLastNote)
+#define SORT_NOTE_SIZE 48
+
+typedef struct SortThread {
   SortAlgorithm algo;
-  GenericData *data; // Copie des données à trier
+  const GenericData *source; // Données d'origine, partagées en lecture seule
+  GenericData *data; // Tampon trié, réutilisé d'un tri à l'autre
+  bool release_data; // Tampon rendu dès la fin du tri (résultat non affiché)
   double elapsed_time;
   bool running;
   bool completed;
-  bool should_stop;
+  SortProgress progress;
+  char note[SORT_NOTE_SIZE]; // Choix fait par l'algorithme (ex: dénombrement)
+  SortVerify verify;         // Vérification du tampon après le tri
+  HwCounterSample counters;  // Compteurs matériels du tri (HW_COUNTER_NA)
   void *thread; // Handle de thread (HANDLE sur Windows, pthread_t sur Linux)
+  bool pending; // En file ou en cours dans le pool (protégé par son verrou)
+  struct SortThread *next; // File d'attente du pool
 } SortThread;
 
+// Pool de threads persistant (défini dans sorting.c)
+typedef struct SortPool SortPool;
+
 // Structure pour gérer tous les tris
 typedef struct {
   GenericData *original;
@@ -63,70 +139,196 @@ typedef struct {
   bool completed[SORT_COUNT];
   bool running[SORT_COUNT];
   SortThread threads[SORT_COUNT];
+  SortPool *pool; // NULL = un thread créé par tri
+  int kept_sort;  // Seul tri dont le tampon survit à sa passe (-1: tous)
 } SortManager;
 
 // Noms des algorithmes
 extern const char *SORT_NAMES[SORT_COUNT];
 
+// ==================== GÉNÉRATEUR PSEUDO-ALÉATOIRE ====================
+
+// État xoshiro256**
+typedef struct {
+  unsigned long long s[4];
+} SortRng;
+
+// Initialise l'état à partir d'une graine (splitmix64)
+void RngSeed(SortRng *rng, unsigned long long seed);
+
+// Tirage 64 bits
+unsigned long long RngNext(SortRng *rng);
+
+// Avance de 2^128 tirages (flux indépendant suivant)
+void RngJump(SortRng *rng);
+
+// Entier uniforme dans [0, bound), sans biais de modulo (0: 2^64 valeurs)
+unsigned long long RngRange(SortRng *rng, unsigned long long bound);
+
+// Réel uniforme dans [0, 1)
+double RngDouble(SortRng *rng);
+
 // ==================== GÉNÉRATION DE DONNÉES ====================
 
-// Génère des données aléatoires selon le type
-GenericData *GenerateTypedData(int size, DataType type);
+// Les fonctions de génération sont déterministes pour une graine donnée
+// (quel que soit le nombre de threads utilisés). Les tableaux renvoyés
+// viennent de PageAlloc: à libérer avec PageFree (ou FreeGenericData).
+
+// Génère des données aléatoires selon le type et la distribution, NULL si
+// la mémoire manque
+GenericData *GenerateTypedData(size_t size, DataType type,
+                               DataDistribution dist,
+                               unsigned long long seed);
 
-// Génère des entiers dans une plage (millions/milliards)
-long long *GenerateRandomInts(int size, long long min_val, long long max_val);
+// Génère des entiers dans [min_val, max_val] (millions/milliards), NULL si
+// la mémoire manque ou si min_val > max_val
+long long *GenerateRandomInts(size_t size, long long min_val,
+                              long long max_val, unsigned long long seed);
 
 // Génère des réels aléatoires
-double *GenerateRandomFloats(int size, double min_val, double max_val);
+double *GenerateRandomFloats(size_t size, double min_val, double max_val,
+                             unsigned long long seed);
 
 // Génère des caractères aléatoires
-char *GenerateRandomChars(int size);
+char *GenerateRandomChars(size_t size, unsigned long long seed);
 
-// Génère des chaînes aléatoires
-char **GenerateRandomStrings(int size, int max_len);
+// Génère des chaînes aléatoires dans un bloc unique (*arena, à libérer avec
+// le tableau de pointeurs renvoyé)
+char **GenerateRandomStrings(size_t size, int max_len, unsigned long long seed,
+                             char **arena, size_t *arena_size);
+
+// Recopie des chaînes dans le bloc de gd (type DATA_TYPE_STRING)
+bool SetStringData(GenericData *gd, char *const *strings, size_t size);
 
 // Copie des données génériques
 GenericData *CopyGenericData(const GenericData *src);
 
+// Recopie src dans le tampon dst, réutilisé s'il a le même type et la même
+// taille (sinon réalloué). Les chaînes ne copient que les pointeurs: le
+// tampon partage le bloc de src, qui doit rester valide. Renvoie le tampon.
+GenericData *CopyGenericDataInto(GenericData *dst, const GenericData *src);
+
 // Libère la mémoire
 void FreeGenericData(GenericData *data);
 
+// Taille d'un élément et pointeur brut vers le tableau de données
+size_t GenericElementSize(DataType type);
+void *GenericDataPointer(GenericData *data);
+
 // Ancienne fonction pour compatibilité
-int *GenerateRandomData(int size, int min_val, int max_val);
-int *CopyData(const int *src, int size);
+int *GenerateRandomData(size_t size, int min_val, int max_val);
+int *CopyData(const int *src, size_t size);
 void FreeData(int *data);
 
 // ==================== ALGORITHMES DE TRI (GÉNÉRIQUES) ====================
 
 // Tri à bulles
-void BubbleSortInt(long long *arr, int n);
-void BubbleSortFloat(double *arr, int n);
-void BubbleSortChar(char *arr, int n);
-void BubbleSortString(char **arr, int n);
+void BubbleSortInt(long long *arr, size_t n);
+void BubbleSortFloat(double *arr, size_t n);
+void BubbleSortChar(char *arr, size_t n);
+void BubbleSortString(char **arr, size_t n);
 
 // Tri par insertion
-void InsertionSortInt(long long *arr, int n);
-void InsertionSortFloat(double *arr, int n);
-void InsertionSortChar(char *arr, int n);
-void InsertionSortString(char **arr, int n);
+void InsertionSortInt(long long *arr, size_t n);
+void InsertionSortFloat(double *arr, size_t n);
+void InsertionSortChar(char *arr, size_t n);
+void InsertionSortString(char **arr, size_t n);
 
 // Tri Shell
-void ShellSortInt(long long *arr, int n);
-void ShellSortFloat(double *arr, int n);
-void ShellSortChar(char *arr, int n);
-void ShellSortString(char **arr, int n);
+void ShellSortInt(long long *arr, size_t n);
+void ShellSortFloat(double *arr, size_t n);
+void ShellSortChar(char *arr, size_t n);
+void ShellSortString(char **arr, size_t n);
 
 // Tri rapide
-void QuickSortInt(long long *arr, int low, int high);
-void QuickSortFloat(double *arr, int low, int high);
-void QuickSortChar(char *arr, int low, int high);
-void QuickSortString(char **arr, int low, int high);
+void QuickSortInt(long long *arr, ptrdiff_t low, ptrdiff_t high);
+void QuickSortFloat(double *arr, ptrdiff_t low, ptrdiff_t high);
+void QuickSortChar(char *arr, ptrdiff_t low, ptrdiff_t high);
+void QuickSortString(char **arr, ptrdiff_t low, ptrdiff_t high);
+
+// Introsort (médiane de 3/ninther, insertion < 16, heapsort en profondeur)
+void IntroSortInt(long long *arr, size_t n);
+void IntroSortFloat(double *arr, size_t n);
+void IntroSortChar(char *arr, size_t n);
+void IntroSortString(char **arr, size_t n);
+
+// Tri fusion ascendant (stable, O(n log n), tampon de n éléments)
+void MergeSortInt(long long *arr, size_t n);
+void MergeSortFloat(double *arr, size_t n);
+void MergeSortChar(char *arr, size_t n);
+void MergeSortString(char **arr, size_t n);
+
+// TimSort (stable, quasi linéaire sur données presque triées)
+void TimSortInt(long long *arr, size_t n);
+void TimSortFloat(double *arr, size_t n);
+void TimSortChar(char *arr, size_t n);
+void TimSortString(char **arr, size_t n);
+
+// Tri par base LSD 11 bits (clés 64 bits, passes constantes sautées)
+void RadixSortInt(long long *arr, size_t n);
+void RadixSortFloat(double *arr, size_t n);
+
+// Tri par dénombrement O(n + k) si la plage k des clés est réduite, sinon
+// introsort (la décision est consignée dans la note du tri)
+void CountingSortInt(long long *arr, size_t n);
+void CountingSortChar(char *arr, size_t n);
+
+// Quicksort à trois voies sur des clés de 8 octets (préfixes gros-boutistes
+// rangés à côté des pointeurs); strcmp seulement en cas d'égalité de clé
+void MultikeySortString(char **arr, size_t n);
+
+// Tri externe: suites triées écrites en fichiers temporaires puis fusion à
+// k voies, la mémoire de travail étant bornée par GetExternalMemory()
+void ExternalSortInt(long long *arr, size_t n);
+void ExternalSortFloat(double *arr, size_t n);
+void ExternalSortChar(char *arr, size_t n);
 
 // Anciennes fonctions pour compatibilité
-void BubbleSort(int *arr, int n);
-void InsertionSort(int *arr, int n);
-void ShellSort(int *arr, int n);
-void QuickSort(int *arr, int low, int high);
+void BubbleSort(int *arr, size_t n);
+void InsertionSort(int *arr, size_t n);
+void ShellSort(int *arr, size_t n);
+void QuickSort(int *arr, ptrdiff_t low, ptrdiff_t high);
+void IntroSort(int *arr, size_t n);
+void MergeSort(int *arr, size_t n);
+void TimSort(int *arr, size_t n);
+
+// ==================== TRI MULTI-CŒURS ====================
+
+// Nombre maximal de threads d'un tri parallèle
+#define PARALLEL_MAX_THREADS 64
+
+// Nombre de cœurs logiques de la machine
+int GetCpuCount(void);
+
+// Threads utilisés par SORT_PARALLEL (0 = un par cœur)
+void SetSortThreadCount(int threads);
+int GetSortThreadCount(void);
+
+// Budget mémoire de SORT_EXTERNAL en octets (0 = défaut, 8 Mo)
+void SetExternalMemory(size_t bytes);
+size_t GetExternalMemory(void);
+
+// Tri fusion parallèle sur threads (0 = GetSortThreadCount())
+void ParallelSortGeneric(GenericData *data, int threads);
+
+// ==================== TRI ADAPTATIF (SORT_AUTO) ====================
+
+// Seuils de taille utilisés par SORT_AUTO
+typedef struct {
+  size_t insertion_max;      // Insertion jusqu'à cette taille
+  size_t radix_min;          // Radix (entiers, réels) dès cette taille
+  size_t parallel_min;       // Tri parallèle dès cette taille (vs introsort)
+  size_t parallel_radix_min; // Tri parallèle dès cette taille (vs radix)
+  bool calibrated;        // Faux: valeurs par défaut
+} AutoSortThresholds;
+
+// Mesure les seuils sur cette machine (micro-benchmark sur entiers, une
+// fraction de seconde). Appelée par le premier tri SORT_AUTO, hors de son
+// temps mesuré; sans effet si une mesure est faite ou en cours. Les tris
+// lancés avant la fin de la mesure utilisent les seuils par défaut.
+void CalibrateAutoSort(void);
+
+AutoSortThresholds GetAutoSortThresholds(void);
 
 // ==================== TRI PARALLÈLE ====================
 
@@ -136,29 +338,147 @@ void StartSortThread(SortThread *st, SortAlgorithm algo, GenericData *data);
 // Attend la fin d'un thread de tri
 void WaitSortThread(SortThread *st);
 
-// Arrête un thread de tri
+// Arrête un thread de tri (arrêt coopératif: le noyau s'interrompt à sa
+// prochaine publication de progression, puis le thread est rejoint)
 void StopSortThread(SortThread *st);
 
-// Lance tous les tris en parallèle
+// Avancement estimé d'un tri (0..1) à partir des compteurs publiés
+float SortThreadProgress(const SortThread *st);
+
+// ==================== POOL DE THREADS ====================
+
+// Crée un pool de workers (0 = SORT_COUNT, un par algorithme)
+SortPool *CreateSortPool(int workers);
+
+// Arrête les workers après la fin des tâches en cours et libère le pool
+void DestroySortPool(SortPool *pool);
+
+// Met un tri en file; la copie des données est faite par le worker
+void SubmitSortJob(SortPool *pool, SortThread *st, SortAlgorithm algo,
+                   const GenericData *data);
+
+// Attend qu'un tri soumis au pool soit terminé (ou annulé)
+void WaitSortJob(SortPool *pool, SortThread *st);
+
+// Lance un seul tri (via le pool s'il existe), les autres ne sont pas
+// touchés: les passes de mesure enchaînent ainsi les algorithmes un par un.
+// Hors kept_sort, le tampon est rendu au pool dès la vérification faite:
+// seuls les tris en cours (au plus un par worker) détiennent une copie.
+void StartSort(SortManager *manager, GenericData *original,
+               SortAlgorithm algo);
+
+// Lance tous les tris en parallèle (via le pool s'il existe). Chaque tri
+// recopie l'original dans son tampon (voir StartSort pour sa durée de vie)
 void StartAllSorts(SortManager *manager, GenericData *original);
 
 // Vérifie si tous les tris sont terminés
 bool AllSortsCompleted(SortManager *manager);
 
-// Arrête tous les tris
+// Arrête tous les tris (les tampons sont conservés)
 void StopAllSorts(SortManager *manager);
 
+// Libère les tampons des tris (après StopAllSorts)
+void ReleaseSortBuffers(SortManager *manager);
+
+// Libère les tampons gardés par le pool pour les passes suivantes; le
+// tampon de kept_sort reste (fin d'un lancement)
+void TrimSortBuffers(SortManager *manager);
+
 // ==================== MESURE DE PERFORMANCE ====================
 
-// Exécute un tri et mesure le temps
+// Indique si un algorithme s'applique à un type (ex: radix = nombres)
+bool SortSupportsType(SortAlgorithm algo, DataType type);
+
+// Indique si un algorithme préserve l'ordre des éléments égaux
+bool SortIsStable(SortAlgorithm algo);
+
+// Exécute un tri et mesure le temps (-1 si l'algorithme ne s'applique pas)
+// sur l'horloge monotone, compteurs matériels capturés autour du tri
 double TimedSortGeneric(SortAlgorithm algo, GenericData *data);
 
+// TimedSortGeneric avec progression publiée dans progress: le tri
+// s'interrompt quand progress->should_stop passe à 1
+double TimedSortTracked(SortAlgorithm algo, GenericData *data,
+                        SortProgress *progress);
+
+// Travail total attendu (comparaisons + déplacements) pour n éléments
+double ExpectedSortWork(SortAlgorithm algo, size_t n);
+
+// Note laissée par le dernier tri du thread courant ("" si aucune)
+const char *SortLastNote(void);
+
+// Compteurs matériels du dernier tri du thread courant
+HwCounterSample SortLastCounters(void);
+
 // Ancienne fonction pour compatibilité
-double TimedSort(SortAlgorithm algo, int *data_copy, int size);
+double TimedSort(SortAlgorithm algo, int *data_copy, size_t size);
+
+// Jeu d'instructions SIMD détecté à l'exécution ("AVX2" ou "scalaire")
+const char *SortIsaName(void);
+
+// Jeu d'instructions utilisé par un algorithme pour un type (les feuilles
+// de Quick Sort sur entiers et réels passent par un réseau de tri SIMD)
+const char *SortKernelIsa(SortAlgorithm algo, DataType type);
 
-// Vérifie si des données sont triées
+// Vérifie si des données sont triées: paires voisines comparées en SIMD
+// (si disponible), par blocs répartis entre les threads
 bool IsSortedGeneric(const GenericData *data);
-bool IsSorted(const int *arr, int n);
+
+// Empreinte du contenu indépendante de l'ordre: somme (modulo 2^64) d'un
+// hachage de chaque élément (valeur, ou caractères pour les chaînes)
+unsigned long long GenericDataChecksum(const GenericData *data);
+
+// Calcule et enregistre l'empreinte de data (fichier chargé, saisie)
+void UpdateGenericDataChecksum(GenericData *data);
+
+// Vérifie en une seule lecture que sorted est trié et contient les mêmes
+// éléments que original (même taille, même empreinte). L'empreinte de
+// original est recalculée si elle est absente; original NULL: ordre seul.
+SortVerify VerifySortedGeneric(const GenericData *sorted,
+                               const GenericData *original);
+bool IsSorted(const int *arr, size_t n);
+
+// ==================== STATISTIQUES DE MESURE ====================
+
+// Résumé de mesures répétées (secondes)
+typedef struct {
+  int count;
+  double min;
+  double median;
+  double mean;
+  double stddev; // Écart type de l'échantillon (n - 1)
+  double p95;
+  double max;
+  double ci_low; // Intervalle de confiance à 95 % de la médiane
+  double ci_high;
+} SortStats;
+
+// Calcule les statistiques de count mesures (samples est trié sur place)
+SortStats ComputeSortStats(double *samples, int count);
+
+// Modèles de complexité comparés aux temps mesurés
+typedef enum {
+  SCALING_LINEAR,
+  SCALING_NLOGN,
+  SCALING_QUADRATIC,
+  SCALING_MODEL_COUNT
+} ScalingModel;
+
+extern const char *SCALING_MODEL_NAMES[SCALING_MODEL_COUNT];
+
+typedef struct {
+  int points;
+  double exponent;  // Pente de log t en fonction de log n
+  double intercept; // t ~ exp(intercept) * n^exponent
+  ScalingModel model;                // Modèle le plus proche
+  double coef[SCALING_MODEL_COUNT];  // t ~ coef * f(n)
+  double error[SCALING_MODEL_COUNT]; // Écart quadratique moyen en log
+} ScalingFit;
+
+// Ajuste times (s) aux tailles sizes: exposant et modèles n, n log n, n².
+// Les temps <= 0 sont ignorés; false sans deux tailles distinctes.
+bool FitSortScaling(const double *sizes, const double *times, int count,
+                    ScalingFit *fit);
 
 // ==================== FORMATAGE TEMPS ====================
 
@@ -0,0 +1,187 @@
+/**
+ * SWEEP.C - Balayage de tailles dans un thread d'arrière-plan
+ */
+
+#include "sweep.h"
+#include <math.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <stdint.h>
+#endif
+
+// Accès atomiques à l'état partagé avec l'UI (C99: builtins GCC)
+#if defined(__GNUC__)
+#define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define ATOMIC_LOAD(p) (*(p))
+#define ATOMIC_STORE(p, v) (*(p) = (v))
+#endif
+
+// En dessous, un temps est trop bruité pour extrapoler une pente
+#define SWEEP_MIN_SLOPE_TIME 0.001
+
+// Série géométrique min_size..max_size, SWEEP_STEPS_PER_DECADE par décade
+static int BuildSizes(SizeSweep *sw) {
+  int count = 0;
+  for (int k = 0; count < SWEEP_MAX_SIZES; k++) {
+    double n = sw->min_size * pow(10.0, (double)k / SWEEP_STEPS_PER_DECADE);
+    if (n > sw->max_size * 1.0001)
+      break;
+    sw->sizes[count++] = (size_t)(n + 0.5);
+  }
+  return count;
+}
+
+// Temps prévu de l'algorithme à la taille k: modèle théorique depuis la
+// dernière mesure, ou pente mesurée si elle est plus forte (Quick Sort
+// quadratique sur données triées). 0 si aucune mesure.
+static double PredictTime(const SizeSweep *sw, SortAlgorithm algo, int k) {
+  if (k == 0 || sw->times[k - 1][algo] <= 0)
+    return 0;
+  double t = sw->times[k - 1][algo];
+  size_t n = sw->sizes[k - 1];
+  double predicted = t * ExpectedSortWork(algo, sw->sizes[k]) /
+                     ExpectedSortWork(algo, n);
+
+  if (k >= 2 && sw->times[k - 2][algo] > SWEEP_MIN_SLOPE_TIME &&
+      t > SWEEP_MIN_SLOPE_TIME) {
+    double slope = log(t / sw->times[k - 2][algo]) /
+                   log((double)n / sw->sizes[k - 2]);
+    double measured = t * pow((double)sw->sizes[k] / n, slope);
+    if (measured > predicted)
+      predicted = measured;
+  }
+  return predicted;
+}
+
+static void RunSizeSweep(SizeSweep *sw) {
+  GenericData *work = NULL;
+  bool dropped[SORT_COUNT] = {false};
+  bool stopped = false;
+
+  for (int k = 0; k < sw->size_count && !stopped; k++) {
+    GenericData *input =
+        GenerateTypedData(sw->sizes[k], sw->type, sw->dist, sw->seed);
+    if (!input) {
+      sw->ok = false;
+      break;
+    }
+
+    for (int a = 0; a < SORT_COUNT && !stopped; a++) {
+      SortAlgorithm algo = (SortAlgorithm)a;
+      double t = SWEEP_SKIPPED;
+      if (!SortSupportsType(algo, sw->type)) {
+        t = -1;
+      } else if (!dropped[a] && PredictTime(sw, algo, k) > sw->budget) {
+        dropped[a] = true;
+      }
+
+      if (t == SWEEP_SKIPPED && !dropped[a]) {
+        // Même tampon de travail pour tous les tris: une seule copie
+        work = CopyGenericDataInto(work, input);
+        if (work)
+          t = TimedSortTracked(algo, work, &sw->progress);
+        stopped = ATOMIC_LOAD(&sw->progress.should_stop);
+        // Tri interrompu: mesure incomplète, ligne non publiée
+        if (stopped || !work)
+          t = SWEEP_SKIPPED;
+        if (t > sw->budget || !work)
+          dropped[a] = true;
+      }
+      sw->times[k][a] = t;
+      ATOMIC_STORE(&sw->step, sw->step + 1);
+    }
+
+    FreeGenericData(input);
+    if (!stopped)
+      ATOMIC_STORE(&sw->sizes_done, k + 1);
+  }
+
+  FreeGenericData(work);
+  ATOMIC_STORE(&sw->finished, 1);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI SweepThreadFunc(LPVOID arg) {
+  RunSizeSweep((SizeSweep *)arg);
+  return 0;
+}
+#else
+static void *SweepThreadFunc(void *arg) {
+  RunSizeSweep((SizeSweep *)arg);
+  return NULL;
+}
+#endif
+
+static void JoinSweepThread(SizeSweep *sw) {
+  if (sw->thread) {
+#ifdef _WIN32
+    WaitForSingleObject(sw->thread, INFINITE);
+    CloseHandle(sw->thread);
+#else
+    pthread_join((pthread_t)(uintptr_t)sw->thread, NULL);
+#endif
+    sw->thread = NULL;
+  }
+  sw->active = false;
+}
+
+bool StartSizeSweep(SizeSweep *sw) {
+  if (sw->active)
+    return false;
+
+  sw->size_count = BuildSizes(sw);
+  for (int k = 0; k < sw->size_count; k++) {
+    for (int a = 0; a < SORT_COUNT; a++)
+      sw->times[k][a] = SWEEP_SKIPPED;
+  }
+  sw->sizes_done = 0;
+  sw->finished = 0;
+  sw->step = 0;
+  sw->ok = true;
+  memset(&sw->progress, 0, sizeof(sw->progress));
+  sw->active = true;
+
+#ifdef _WIN32
+  sw->thread = CreateThread(NULL, 0, SweepThreadFunc, sw, 0, NULL);
+#else
+  pthread_t tid;
+  if (pthread_create(&tid, NULL, SweepThreadFunc, sw) == 0)
+    sw->thread = (void *)(uintptr_t)tid;
+  else
+    sw->thread = NULL;
+#endif
+  if (!sw->thread) // Pas de thread: balayage exécuté sur place
+    RunSizeSweep(sw);
+  return true;
+}
+
+float SizeSweepProgress(const SizeSweep *sw) {
+  int total = sw->size_count * SORT_COUNT;
+  if (!sw->active || total <= 0)
+    return sw->active ? 0.0f : 1.0f;
+  return (float)ATOMIC_LOAD(&sw->step) / (float)total;
+}
+
+int SizeSweepSizesDone(const SizeSweep *sw) {
+  return ATOMIC_LOAD(&sw->sizes_done);
+}
+
+bool PollSizeSweep(SizeSweep *sw) {
+  if (!sw->active || !ATOMIC_LOAD(&sw->finished))
+    return false;
+  JoinSweepThread(sw);
+  return true;
+}
+
+void CancelSizeSweep(SizeSweep *sw) {
+  if (!sw->active)
+    return;
+  ATOMIC_STORE(&sw->progress.should_stop, 1);
+  JoinSweepThread(sw);
+}
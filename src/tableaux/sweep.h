@@ -0,0 +1,67 @@
+/**
+ * SWEEP.H - Balayage de tailles en arrière-plan (analyse de complexité)
+ *
+ * Chaque algorithme est mesuré sur une série géométrique de tailles, un tri
+ * à la fois pour ne pas fausser les temps. Un algorithme est abandonné dès
+ * que son prochain tri dépasserait le budget de temps (tris quadratiques).
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "sorting.h"
+
+// Série par défaut: 1k -> 10M, deux tailles par décade
+#define SWEEP_MIN_SIZE 1000
+#define SWEEP_MAX_SIZE 10000000
+#define SWEEP_STEPS_PER_DECADE 2
+#define SWEEP_MAX_SIZES 32
+
+// Temps prévu max d'un tri (secondes)
+#define SWEEP_DEFAULT_BUDGET 2.0
+
+// Temps d'un algorithme abandonné (budget) ou pas encore mesuré; -1 reste
+// "non applicable" comme pour TimedSortGeneric
+#define SWEEP_SKIPPED (-2.0)
+
+typedef struct {
+  // Rempli par l'appelant avant StartSizeSweep
+  DataType type;
+  DataDistribution dist;
+  unsigned long long seed;
+  size_t min_size;
+  size_t max_size;
+  double budget;
+
+  // Résultats: une ligne publiée par taille terminée
+  size_t sizes[SWEEP_MAX_SIZES];
+  int size_count;
+  double times[SWEEP_MAX_SIZES][SORT_COUNT];
+  volatile int sizes_done; // Lignes complètes (lues après ce compteur)
+
+  // État interne
+  void *thread;
+  bool active;           // Lancé et pas encore récupéré
+  volatile int finished; // Écrit par le thread
+  volatile int step;     // Tris effectués (ou sautés)
+  bool ok;               // Faux si une génération a échoué
+  SortProgress progress; // should_stop interrompt le tri en cours
+} SizeSweep;
+
+// Lance le balayage dans un thread (sur place si le thread ne peut pas être
+// créé). false si un balayage est déjà en cours.
+bool StartSizeSweep(SizeSweep *sw);
+
+// Avancement (0..1)
+float SizeSweepProgress(const SizeSweep *sw);
+
+// Nombre de lignes sizes/times complètes, lisibles pendant le balayage
+int SizeSweepSizesDone(const SizeSweep *sw);
+
+// Vrai une seule fois, quand le balayage lancé est terminé (thread rejoint)
+bool PollSizeSweep(SizeSweep *sw);
+
+// Interrompt le balayage (tri en cours compris) et attend le thread
+void CancelSizeSweep(SizeSweep *sw);
+
+#endif // SWEEP_H
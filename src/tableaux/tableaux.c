@@ -8,33 +8,54 @@
  */
 
 #include "tableaux.h"
+#include "dataset.h"
+#include "pagealloc.h"
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 static const char *TYPE_NAMES[] = {"Entiers", "Reels", "Caracteres", "Chaines"};
 
+// Jeu de données binaire des boutons Import/Export (à côté des résultats)
+#define DATASET_FILE "donnees_tri" DATASET_EXTENSION
+
+// Boutons et colonnes de résultats des algorithmes: SORT_PER_ROW par ligne
+#define SORT_PER_ROW 7
+#define SORT_BTN_STEP 135
+
+// Répétitions proposées par le bouton Bench, précédées de BENCH_WARMUP
+// passes ignorées (tampons à allouer, caches et fréquence à stabiliser)
+static const int BENCH_REPS[] = {1, 5, 10, TAB_BENCH_MAX_REPS};
+#define BENCH_REPS_COUNT ((int)(sizeof(BENCH_REPS) / sizeof(BENCH_REPS[0])))
+#define BENCH_WARMUP 1
+
 // ==================== HELPERS ====================
 
 static void ClearSortedData(TableauxScreen *screen) {
+  // La sauvegarde en cours lit les tampons: interrompue (fichier partiel)
+  CancelResultExport(&screen->export_job);
   for (int i = 0; i < SORT_COUNT; i++) {
-    if (screen->sort_manager.sorted[i]) {
-      FreeGenericData(screen->sort_manager.sorted[i]);
-      screen->sort_manager.sorted[i] = NULL;
+    // sorted[i] peut pointer sur la copie encore détenue par le thread
+    GenericData *sorted = screen->sort_manager.sorted[i];
+    if (sorted && sorted != screen->sort_manager.threads[i].data) {
+      FreeGenericData(sorted);
     }
+    screen->sort_manager.sorted[i] = NULL;
     screen->sort_done[i] = false;
     screen->sort_times[i] = 0;
     screen->sort_running[i] = false;
     screen->sort_elapsed[i] = 0;
+    memset(&screen->sort_stats[i], 0, sizeof(SortStats));
   }
-  if (screen->display_sorted) {
-    FreeGenericData(screen->display_sorted);
-    screen->display_sorted = NULL;
-  }
+  // display_sorted emprunte le tampon d'un tri: rien à libérer
+  screen->display_sorted = NULL;
 }
 
 static void ResetScreen(TableauxScreen *screen) {
+  CancelResultExport(&screen->export_job);
   if (screen->original_data) {
     FreeGenericData(screen->original_data);
     screen->original_data = NULL;
@@ -47,6 +68,112 @@ static void ResetScreen(TableauxScreen *screen) {
   screen->status_message[0] = '\0';
 }
 
+// Lance le premier tri pas encore fait de la passe
+static void StartNextSort(TableauxScreen *screen) {
+  for (int j = 0; j < SORT_COUNT; j++) {
+    if (screen->sort_done[j])
+      continue;
+    screen->sort_start_times[j] = GetTime();
+    screen->sort_running[j] = true;
+    screen->sort_progress_count[j] = 0;
+    StartSort(&screen->sort_manager, screen->original_data, (SortAlgorithm)j);
+    return;
+  }
+}
+
+// Lance une passe de tous les tris sur les données originales. En mode
+// benchmark, les algorithmes passent un par un (comme le balayage): en
+// parallèle, chaque mesure inclurait la concurrence des autres tris pour les
+// coeurs et la bande passante mémoire.
+static void LaunchSortPass(TableauxScreen *screen) {
+  ClearSortedData(screen);
+  screen->state = TAB_STATE_SORTING;
+  // Empreinte de référence des vérifications (fichier importé, saisie)
+  if (!screen->original_data->has_checksum)
+    UpdateGenericDataChecksum(screen->original_data);
+  // Seul le tri affiché garde son tampon, les autres le rendent au pool
+  screen->sort_manager.kept_sort = screen->selected_sort;
+  screen->global_start_time = GetTime();
+
+  if (screen->bench_total > 1) {
+    StartNextSort(screen);
+    return;
+  }
+
+  StartAllSorts(&screen->sort_manager, screen->original_data);
+  for (int j = 0; j < SORT_COUNT; j++) {
+    screen->sort_start_times[j] = screen->global_start_time;
+    screen->sort_running[j] = true;
+    screen->sort_done[j] = false;
+    screen->sort_progress_count[j] = 0; // Reset progress tracking
+  }
+}
+
+// Insère un point en gardant l'historique trié par taille
+static void AddHistoryPoint(PerformanceHistory *history,
+                            const PerformancePoint *point) {
+  if (history->count == history->capacity) {
+    int capacity = history->capacity ? history->capacity * 2 : 16;
+    PerformancePoint *points = (PerformancePoint *)realloc(
+        history->points, capacity * sizeof(PerformancePoint));
+    if (!points)
+      return;
+    history->points = points;
+    history->capacity = capacity;
+  }
+
+  int pos = history->count;
+  while (pos > 0 && history->points[pos - 1].size > point->size)
+    pos--;
+  memmove(&history->points[pos + 1], &history->points[pos],
+          (history->count - pos) * sizeof(PerformancePoint));
+  history->points[pos] = *point;
+  history->count++;
+}
+
+// Fin du lancement: statistiques des passes mesurées, temps affiché =
+// médiane, puis ajout d'un point à l'historique
+static void FinishSortRun(TableauxScreen *screen) {
+  int reps = screen->bench_total - screen->bench_warmup;
+  PerformancePoint point;
+  memset(&point, 0, sizeof(point));
+  point.size = screen->data_size;
+  point.type = screen->data_type;
+  point.dist = screen->original_data->dist;
+
+  for (int a = 0; a < SORT_COUNT; a++) {
+    if (screen->sort_times[a] < 0)
+      continue; // Non applicable
+    screen->sort_stats[a] = ComputeSortStats(screen->bench_samples[a], reps);
+    screen->sort_times[a] = screen->sort_stats[a].median;
+    point.stats[a] = screen->sort_stats[a];
+  }
+  AddHistoryPoint(&screen->history, &point);
+  TrimSortBuffers(&screen->sort_manager);
+  screen->state = TAB_STATE_DONE;
+}
+
+// Verse dans l'historique les tailles terminées du balayage (une mesure
+// par algorithme, les abandons restent vides)
+static void AddSweepPoints(TableauxScreen *screen) {
+  const SizeSweep *sw = &screen->sweep;
+  int ready = SizeSweepSizesDone(sw);
+  for (; screen->sweep_consumed < ready; screen->sweep_consumed++) {
+    int k = screen->sweep_consumed;
+    PerformancePoint point;
+    memset(&point, 0, sizeof(point));
+    point.size = sw->sizes[k];
+    point.type = sw->type;
+    point.dist = sw->dist;
+    for (int a = 0; a < SORT_COUNT; a++) {
+      double t = sw->times[k][a];
+      if (t >= 0)
+        point.stats[a] = ComputeSortStats(&t, 1);
+    }
+    AddHistoryPoint(&screen->history, &point);
+  }
+}
+
 static Color GetAlgoColor(int algo) {
   switch (algo) {
   case SORT_BUBBLE:
@@ -57,6 +184,24 @@ static Color GetAlgoColor(int algo) {
     return (Color){255, 193, 7, 255};
   case SORT_QUICK:
     return COLOR_NEON_GREEN;
+  case SORT_INTRO:
+    return COLOR_NEON_PURPLE;
+  case SORT_RADIX:
+    return (Color){255, 105, 180, 255};
+  case SORT_PARALLEL:
+    return (Color){0, 230, 230, 255};
+  case SORT_COUNTING:
+    return (Color){173, 255, 47, 255};
+  case SORT_MERGE:
+    return (Color){255, 140, 105, 255};
+  case SORT_TIM:
+    return (Color){135, 206, 250, 255};
+  case SORT_EXTERNAL:
+    return (Color){210, 180, 140, 255};
+  case SORT_MULTIKEY:
+    return (Color){186, 85, 211, 255};
+  case SORT_AUTO:
+    return (Color){255, 255, 255, 255};
   default:
     return COLOR_TEXT_MAIN;
   }
@@ -75,7 +220,7 @@ static void DrawDataPanel(GenericData *data, Rectangle bounds,
   }
 
   char countStr[32];
-  snprintf(countStr, sizeof(countStr), "(%d elements)", data->size);
+  snprintf(countStr, sizeof(countStr), "(%zu elements)", data->size);
   DrawText(countStr, bounds.x + bounds.width - 130, bounds.y + 5, 12,
            COLOR_TEXT_DIM);
 
@@ -95,13 +240,19 @@ static void DrawDataPanel(GenericData *data, Rectangle bounds,
 
   char buffer[64];
 
-  for (int i = 0; i < data->size; i++) {
-    int row = i / items_per_row;
-    int col = i % items_per_row;
+  // Parcours limité aux lignes visibles (tableaux de plusieurs milliards)
+  size_t first_row = scroll_y > 2 * item_height
+                         ? (size_t)(scroll_y / item_height) - 1
+                         : 0;
+  for (size_t i = first_row * items_per_row; i < data->size; i++) {
+    size_t row = i / items_per_row;
+    int col = (int)(i % items_per_row);
     int x = x_offset + col * char_width;
-    int y = y_offset + row * item_height;
+    double y = y_offset + (double)row * item_height;
 
-    if (y < bounds.y - item_height || y > bounds.y + bounds.height)
+    if (y > bounds.y + bounds.height)
+      break;
+    if (y < bounds.y - item_height)
       continue;
 
     switch (data->type) {
@@ -118,14 +269,210 @@ static void DrawDataPanel(GenericData *data, Rectangle bounds,
       snprintf(buffer, sizeof(buffer), "%.8s", data->data.string_data[i]);
       break;
     }
-    DrawText(buffer, x, y, 12, COLOR_TEXT_MAIN);
+    DrawText(buffer, x, (int)y, 12, COLOR_TEXT_MAIN);
   }
   EndScissorMode();
 }
 
 // ==================== GRAPHIQUE ====================
 
+static void DrawGlowSegment(Vector2 from, Vector2 to, Color color) {
+  // Glow effect
+  Color glowColor = color;
+  glowColor.a = 40;
+  DrawLineEx(from, to, 6.0f, glowColor);
+  glowColor.a = 80;
+  DrawLineEx(from, to, 4.0f, glowColor);
+  // Ligne principale
+  DrawLineEx(from, to, 2.5f, color);
+}
+
+// Position (0..1) de v entre lo et hi en échelle logarithmique
+static float LogScale(double v, double lo, double hi) {
+  if (hi <= lo)
+    return 0.5f;
+  return (float)((log10(v) - log10(lo)) / (log10(hi) - log10(lo)));
+}
+
+// Points de l'historique affichés: type et distribution courants
+static bool HistoryPointShown(const TableauxScreen *screen,
+                              const PerformancePoint *point) {
+  return point->type == screen->data_type && point->dist == screen->data_dist;
+}
+
+// Temps médian en fonction de la taille (échelles log) pour le type et la
+// distribution courants, barre d'erreur = IC à 95 % de la médiane. Chaque
+// algorithme est ajusté (droite en pointillés) et sa légende donne
+// l'exposant mesuré, le modèle le plus proche et l'exposant théorique.
+static void DrawHistoryGraph(TableauxScreen *screen, Rectangle bounds) {
+  DrawPanel(bounds, "Historique des mesures", COLOR_NEON_BLUE);
+
+  const PerformanceHistory *history = &screen->history;
+  size_t minSize = SIZE_MAX, maxSize = 0;
+  double minTime = 1e300, maxTime = 0;
+  for (int p = 0; p < history->count; p++) {
+    const PerformancePoint *point = &history->points[p];
+    if (!HistoryPointShown(screen, point))
+      continue;
+    for (int a = 0; a < SORT_COUNT; a++) {
+      const SortStats *st = &point->stats[a];
+      if (st->count == 0)
+        continue;
+      minSize = point->size < minSize ? point->size : minSize;
+      maxSize = point->size > maxSize ? point->size : maxSize;
+      minTime = fmin(minTime, st->ci_low);
+      maxTime = fmax(maxTime, st->ci_high);
+    }
+  }
+
+  if (maxSize == 0) {
+    DrawText("Aucune mesure pour ce type: lancez un tri (Bench xN pour les "
+             "barres d'erreur) ou un Sweep",
+             bounds.x + 40, bounds.y + bounds.height / 2, 16, COLOR_TEXT_DIM);
+    return;
+  }
+
+  // Temps nuls (entrées minuscules) ramenés à 1 ns, marges multiplicatives
+  minTime = fmax(minTime, 1e-9) / 1.5;
+  maxTime = fmax(maxTime, 1e-9) * 1.5;
+  double lowSize = minSize / 1.5, highSize = maxSize * 1.5;
+
+  float margin = 50;
+  float graphX = bounds.x + margin + 30;
+  float graphY = bounds.y + 50;
+  float graphW = bounds.width - margin - 280;
+  float graphH = bounds.height - 100;
+
+  DrawLineEx((Vector2){graphX, graphY + graphH},
+             (Vector2){graphX + graphW, graphY + graphH}, 2.0f, COLOR_TEXT_DIM);
+  DrawLineEx((Vector2){graphX, graphY}, (Vector2){graphX, graphY + graphH},
+             2.0f, COLOR_TEXT_DIM);
+  DrawText("Taille (log)", graphX + graphW / 2 - 30, graphY + graphH + 18, 12,
+           COLOR_NEON_BLUE);
+  DrawText("Temps median (log)", graphX, graphY - 18, 12, COLOR_NEON_BLUE);
+
+  char label[48];
+  FormatTimeString(minTime, label, sizeof(label));
+  DrawText(label, bounds.x + 8, graphY + graphH - 6, 11, COLOR_TEXT_DIM);
+  FormatTimeString(maxTime, label, sizeof(label));
+  DrawText(label, bounds.x + 8, graphY - 6, 11, COLOR_TEXT_DIM);
+  snprintf(label, sizeof(label), "%zu", minSize);
+  DrawText(label, graphX + LogScale(minSize, lowSize, highSize) * graphW - 10,
+           graphY + graphH + 5, 11, COLOR_TEXT_DIM);
+  if (maxSize != minSize) {
+    snprintf(label, sizeof(label), "%zu", maxSize);
+    DrawText(label,
+             graphX + LogScale(maxSize, lowSize, highSize) * graphW - 20,
+             graphY + graphH + 5, 11, COLOR_TEXT_DIM);
+  }
+
+  // Médianes d'un algorithme, pour l'ajustement
+  double *fitSizes = (double *)malloc(history->count * sizeof(double));
+  double *fitTimes = (double *)malloc(history->count * sizeof(double));
+  ScalingFit fits[SORT_COUNT];
+  bool fitted[SORT_COUNT] = {false};
+  size_t fitLow[SORT_COUNT], fitHigh[SORT_COUNT];
+
+  for (int a = 0; a < SORT_COUNT; a++) {
+    Color algoColor = GetAlgoColor(a);
+    Vector2 prev = {0, 0};
+    bool hasPrev = false;
+    int fitCount = 0;
+
+    // Points déjà triés par taille: la courbe relie les médianes
+    for (int p = 0; p < history->count; p++) {
+      const PerformancePoint *point = &history->points[p];
+      const SortStats *st = &point->stats[a];
+      if (!HistoryPointShown(screen, point) || st->count == 0)
+        continue;
+      if (fitSizes && fitTimes) {
+        if (fitCount == 0)
+          fitLow[a] = point->size;
+        fitHigh[a] = point->size;
+        fitSizes[fitCount] = point->size;
+        fitTimes[fitCount++] = st->median;
+      }
+
+      float x = graphX + LogScale(point->size, lowSize, highSize) * graphW;
+      float y = graphY + graphH -
+                LogScale(fmax(st->median, 1e-9), minTime, maxTime) * graphH;
+      if (st->count > 1 && st->ci_high > st->ci_low) {
+        float yLow = graphY + graphH -
+                     LogScale(fmax(st->ci_low, 1e-9), minTime, maxTime) * graphH;
+        float yHigh = graphY + graphH -
+                      LogScale(st->ci_high, minTime, maxTime) * graphH;
+        DrawLineEx((Vector2){x, yLow}, (Vector2){x, yHigh}, 1.5f, algoColor);
+        DrawLineEx((Vector2){x - 4, yLow}, (Vector2){x + 4, yLow}, 1.5f,
+                   algoColor);
+        DrawLineEx((Vector2){x - 4, yHigh}, (Vector2){x + 4, yHigh}, 1.5f,
+                   algoColor);
+      }
+
+      Vector2 current = {x, y};
+      if (hasPrev)
+        DrawLineEx(prev, current, 2.0f, Fade(algoColor, 0.7f));
+      DrawCircleV(current, 4, algoColor);
+      prev = current;
+      hasPrev = true;
+    }
+
+    fitted[a] = FitSortScaling(fitSizes, fitTimes, fitCount, &fits[a]);
+    if (!fitted[a])
+      continue;
+
+    // Droite ajustée t = exp(intercept) * n^exposant, en pointillés
+    int segments = 24;
+    for (int s = 0; s < segments; s += 2) {
+      double n0 = fitLow[a] * pow((double)fitHigh[a] / fitLow[a],
+                                  (double)s / segments);
+      double n1 = fitLow[a] * pow((double)fitHigh[a] / fitLow[a],
+                                  (double)(s + 1) / segments);
+      double t0 = exp(fits[a].intercept) * pow(n0, fits[a].exponent);
+      double t1 = exp(fits[a].intercept) * pow(n1, fits[a].exponent);
+      DrawLineEx(
+          (Vector2){graphX + LogScale(n0, lowSize, highSize) * graphW,
+                    graphY + graphH -
+                        LogScale(fmax(t0, 1e-9), minTime, maxTime) * graphH},
+          (Vector2){graphX + LogScale(n1, lowSize, highSize) * graphW,
+                    graphY + graphH -
+                        LogScale(fmax(t1, 1e-9), minTime, maxTime) * graphH},
+          1.0f, Fade(algoColor, 0.5f));
+    }
+  }
+  free(fitSizes);
+  free(fitTimes);
+
+  float legendX = bounds.x + bounds.width - 235;
+  float legendY = bounds.y + 50;
+  DrawText("Algorithme   exposant (theorie)", legendX, legendY, 12,
+           COLOR_TEXT_DIM);
+  legendY += 20;
+  for (int a = 0; a < SORT_COUNT; a++) {
+    DrawRectangle(legendX, legendY + a * 22, 12, 12, GetAlgoColor(a));
+    DrawText(SORT_NAMES[a], legendX + 18, legendY + a * 22, 11,
+             COLOR_TEXT_MAIN);
+    if (fitted[a]) {
+      // Exposant de ExpectedSortWork sur la même plage de tailles
+      double theory = log(ExpectedSortWork(a, fitHigh[a]) /
+                          ExpectedSortWork(a, fitLow[a])) /
+                      log((double)fitHigh[a] / fitLow[a]);
+      snprintf(label, sizeof(label), "n^%.2f (%.2f) ~%s", fits[a].exponent,
+               theory, SCALING_MODEL_NAMES[fits[a].model]);
+      DrawText(label, legendX + 110, legendY + a * 22 + 1, 10,
+               COLOR_TEXT_DIM);
+    }
+  }
+  DrawText("Barres: IC 95% de la mediane (Bench)", legendX,
+           legendY + SORT_COUNT * 22 + 4, 11, COLOR_TEXT_DIM);
+  DrawText("Pointilles: ajustement n^k", legendX,
+           legendY + SORT_COUNT * 22 + 18, 11, COLOR_TEXT_DIM);
+}
+
 static void DrawPerformanceGraph(TableauxScreen *screen, Rectangle bounds) {
+  if (screen->graph_view == GRAPH_HISTORY) {
+    DrawHistoryGraph(screen, bounds);
+    return;
+  }
   DrawPanel(bounds, "Courbes de Tri", COLOR_NEON_BLUE);
 
   // Vérifier si au moins un tri est terminé ou en cours
@@ -203,37 +550,47 @@ static void DrawPerformanceGraph(TableauxScreen *screen, Rectangle bounds) {
     }
 
     if (currentTime > 0) {
+      // Progression réelle publiée par le noyau (1.0 une fois terminé)
+      float progress =
+          done ? 1.0f : SortThreadProgress(&screen->sort_manager.threads[a]);
       float endX = graphX + (float)(currentTime / maxTime) * graphW;
-      Vector2 endPoint = {endX, targetY};
-
-      // Dessiner une courbe exponentielle avec plusieurs segments
-      int segments = 25;
+      Vector2 endPoint = {endX, origin.y + progress * (targetY - origin.y)};
       Vector2 prevPoint = origin;
-      float k = 2.5f; // Paramètre de courbure exponentielle
-      float expK = expf(k);
-
-      for (int s = 1; s <= segments; s++) {
-        float t = (float)s / segments;
-
-        // Courbe exponentielle: y monte rapidement puis ralentit
-        // x avance linéairement, y suit une progression exponentielle
-        float expProgress = (expf(k * t) - 1.0f) / (expK - 1.0f);
+      int pc = screen->sort_progress_count[a];
+
+      if (pc > 0) {
+        // Courbe mesurée: points (temps, progression) enregistrés pendant
+        // le tri, puis le point courant
+        for (int s = 0; s < pc; s++) {
+          Vector2 currentPoint = {
+              graphX +
+                  (float)(screen->sort_progress_times[a][s] / maxTime) * graphW,
+              origin.y +
+                  screen->sort_progress_values[a][s] * (targetY - origin.y)};
+          DrawGlowSegment(prevPoint, currentPoint, algoColor);
+          prevPoint = currentPoint;
+        }
+        DrawGlowSegment(prevPoint, endPoint, algoColor);
+      } else {
+        // Tri trop court pour être échantillonné: courbe exponentielle
+        int segments = 25;
+        float k = 2.5f; // Paramètre de courbure exponentielle
+        float expK = expf(k);
 
-        float x = origin.x + t * (endPoint.x - origin.x);
-        float y = origin.y + expProgress * (endPoint.y - origin.y);
+        for (int s = 1; s <= segments; s++) {
+          float t = (float)s / segments;
 
-        Vector2 currentPoint = {x, y};
+          // Courbe exponentielle: y monte rapidement puis ralentit
+          // x avance linéairement, y suit une progression exponentielle
+          float expProgress = (expf(k * t) - 1.0f) / (expK - 1.0f);
 
-        // Glow effect
-        Color glowColor = algoColor;
-        glowColor.a = 40;
-        DrawLineEx(prevPoint, currentPoint, 6.0f, glowColor);
-        glowColor.a = 80;
-        DrawLineEx(prevPoint, currentPoint, 4.0f, glowColor);
-        // Ligne principale
-        DrawLineEx(prevPoint, currentPoint, 2.5f, algoColor);
+          float x = origin.x + t * (endPoint.x - origin.x);
+          float y = origin.y + expProgress * (endPoint.y - origin.y);
 
-        prevPoint = currentPoint;
+          Vector2 currentPoint = {x, y};
+          DrawGlowSegment(prevPoint, currentPoint, algoColor);
+          prevPoint = currentPoint;
+        }
       }
 
       // Point final
@@ -258,17 +615,26 @@ static void DrawPerformanceGraph(TableauxScreen *screen, Rectangle bounds) {
   for (int a = 0; a < SORT_COUNT; a++) {
     DrawRectangle(legendX, legendY + a * 22, 12, 12, GetAlgoColor(a));
 
+    // Astérisque: tri stable (ordre des éléments égaux préservé)
+    const char *stable = SortIsStable(a) ? "*" : "";
     char legendLabel[64];
-    if (screen->sort_done[a]) {
-      snprintf(legendLabel, sizeof(legendLabel), "%s: %.1f ms", SORT_NAMES[a],
-               screen->sort_times[a] * 1000.0);
+    if (screen->sort_done[a] && screen->sort_times[a] < 0) {
+      snprintf(legendLabel, sizeof(legendLabel), "%s%s: n/a", SORT_NAMES[a],
+               stable);
+    } else if (screen->sort_done[a]) {
+      snprintf(legendLabel, sizeof(legendLabel), "%s%s: %.1f ms",
+               SORT_NAMES[a], stable, screen->sort_times[a] * 1000.0);
     } else if (screen->sort_running[a]) {
-      snprintf(legendLabel, sizeof(legendLabel), "%s: ...", SORT_NAMES[a]);
+      snprintf(legendLabel, sizeof(legendLabel), "%s%s: ...", SORT_NAMES[a],
+               stable);
     } else {
-      snprintf(legendLabel, sizeof(legendLabel), "%s", SORT_NAMES[a]);
+      snprintf(legendLabel, sizeof(legendLabel), "%s%s", SORT_NAMES[a],
+               stable);
     }
     DrawText(legendLabel, legendX + 18, legendY + a * 22, 11, COLOR_TEXT_MAIN);
   }
+  DrawText("* stable", legendX, legendY + SORT_COUNT * 22 + 4, 11,
+           COLOR_TEXT_DIM);
 }
 
 // ==================== SAISIE MANUELLE (Style Python) ====================
@@ -465,6 +831,26 @@ static bool UpdateManualInputCloseButton(TableauxScreen *screen) {
 
 // ==================== DROPDOWN TYPE ====================
 
+// Type de données à gauche, distribution de génération à droite
+#define DIST_COLUMN_OFFSET 124
+#define DIST_COLUMN_WIDTH 130
+
+static void DrawDropdownItem(Rectangle itemRect, const char *text,
+                             bool selected) {
+  Vector2 mouse = GetMousePosition();
+  bool hovered = CheckCollisionPointRec(mouse, itemRect);
+
+  if (selected) {
+    DrawRectangleRounded(itemRect, 0.2f, 4, COLOR_NEON_GREEN);
+    DrawText(text, itemRect.x + 10, itemRect.y + 7, 13, COLOR_BG_DARK);
+  } else if (hovered) {
+    DrawRectangleRounded(itemRect, 0.2f, 4, (Color){60, 80, 100, 255});
+    DrawText(text, itemRect.x + 10, itemRect.y + 7, 13, COLOR_TEXT_WHITE);
+  } else {
+    DrawText(text, itemRect.x + 10, itemRect.y + 7, 13, COLOR_TEXT_MAIN);
+  }
+}
+
 static void DrawTypeDropdown(TableauxScreen *screen, float x, float y) {
   Rectangle mainBtn = {x, y, 120, 36};
   Color btnColor =
@@ -484,21 +870,18 @@ static void DrawTypeDropdown(TableauxScreen *screen, float x, float y) {
 
     for (int i = 0; i < 4; i++) {
       Rectangle itemRect = {x + 2, y + 42 + i * 32, 116, 30};
-      Vector2 mouse = GetMousePosition();
-      bool hovered = CheckCollisionPointRec(mouse, itemRect);
-
-      if (i == (int)screen->data_type) {
-        DrawRectangleRounded(itemRect, 0.2f, 4, COLOR_NEON_GREEN);
-        DrawText(TYPE_NAMES[i], itemRect.x + 10, itemRect.y + 7, 13,
-                 COLOR_BG_DARK);
-      } else if (hovered) {
-        DrawRectangleRounded(itemRect, 0.2f, 4, (Color){60, 80, 100, 255});
-        DrawText(TYPE_NAMES[i], itemRect.x + 10, itemRect.y + 7, 13,
-                 COLOR_TEXT_WHITE);
-      } else {
-        DrawText(TYPE_NAMES[i], itemRect.x + 10, itemRect.y + 7, 13,
-                 COLOR_TEXT_MAIN);
-      }
+      DrawDropdownItem(itemRect, TYPE_NAMES[i], i == (int)screen->data_type);
+    }
+
+    float distX = x + DIST_COLUMN_OFFSET;
+    Rectangle distBg = {distX, y + 40, DIST_COLUMN_WIDTH, DIST_COUNT * 32};
+    DrawRectangleRounded(distBg, 0.1f, 4, COLOR_PANEL);
+    DrawRectRoundedLinesThick(distBg, 0.1f, 4, 2, COLOR_NEON_PURPLE);
+
+    for (int i = 0; i < DIST_COUNT; i++) {
+      Rectangle itemRect = {distX + 2, y + 42 + i * 32, DIST_COLUMN_WIDTH - 4,
+                            30};
+      DrawDropdownItem(itemRect, DIST_NAMES[i], i == (int)screen->data_dist);
     }
   }
 }
@@ -519,6 +902,17 @@ static void UpdateTypeDropdown(TableauxScreen *screen, float x, float y) {
           return;
         }
       }
+      for (int i = 0; i < DIST_COUNT; i++) {
+        Rectangle itemRect = {x + DIST_COLUMN_OFFSET + 2, y + 42 + i * 32,
+                              DIST_COLUMN_WIDTH - 4, 30};
+        if (CheckCollisionPointRec(mouse, itemRect)) {
+          // Le bouton de génération affiche la distribution choisie
+          screen->data_dist = i;
+          screen->btn_generate.text = DIST_NAMES[i];
+          screen->type_dropdown_open = false;
+          return;
+        }
+      }
       screen->type_dropdown_open = false;
     }
   }
@@ -527,10 +921,19 @@ static void UpdateTypeDropdown(TableauxScreen *screen, float x, float y) {
 // ==================== INITIALISATION ====================
 
 void TableauxInit(TableauxScreen *screen) {
+  // L'écran est réinitialisé à chaque visite: le pool de threads, lui, est
+  // créé une seule fois et conservé jusqu'à TableauxUnload
+  SortPool *pool = screen->sort_manager.pool;
+  PerformanceHistory history = screen->history;
   memset(screen, 0, sizeof(TableauxScreen));
+  screen->sort_manager.pool = pool ? pool : CreateSortPool(0);
+  // Tableau de l'historique réutilisé, mesures effacées
+  screen->history = history;
+  screen->history.count = 0;
 
   screen->state = TAB_STATE_IDLE;
   screen->data_type = DATA_TYPE_INT;
+  screen->data_dist = DIST_UNIFORM;
   screen->selected_sort = -1;
   screen->type_dropdown_open = false;
 
@@ -542,14 +945,25 @@ void TableauxInit(TableauxScreen *screen) {
   screen->btn_type_dropdown = CreateButton(160, 60 + NAVBAR_HEIGHT, 120, 38,
                                            "Entiers v", COLOR_NEON_BLUE);
   screen->btn_generate = CreateButton(300, 60 + NAVBAR_HEIGHT, 120, 38,
-                                      "Aleatoire", COLOR_NEON_GREEN);
+                                      DIST_NAMES[screen->data_dist],
+                                      COLOR_NEON_GREEN);
   screen->btn_manual = CreateButton(440, 60 + NAVBAR_HEIGHT, 100, 38, "Manuel",
                                     COLOR_NEON_GREEN);
+  screen->btn_import = CreateButton(560, 60 + NAVBAR_HEIGHT, 90, 38, "Import",
+                                    COLOR_NEON_PURPLE);
+  screen->btn_export = CreateButton(660, 60 + NAVBAR_HEIGHT, 90, 38, "Export",
+                                    COLOR_NEON_PURPLE);
+  screen->btn_bench = CreateButton(770, 60 + NAVBAR_HEIGHT, 100, 38,
+                                   "Bench x1", COLOR_NEON_ORANGE);
+  screen->btn_sweep = CreateButton(880, 60 + NAVBAR_HEIGHT, 90, 38, "Sweep",
+                                   COLOR_NEON_ORANGE);
 
   int sortBtnX = 20;
   for (int i = 0; i < SORT_COUNT; i++) {
-    screen->btn_sort[i] = CreateButton(sortBtnX + i * 155, 110 + NAVBAR_HEIGHT,
-                                       145, 38, SORT_NAMES[i], GetAlgoColor(i));
+    int row = i / SORT_PER_ROW, col = i % SORT_PER_ROW;
+    screen->btn_sort[i] = CreateButton(
+        sortBtnX + col * SORT_BTN_STEP, 108 + NAVBAR_HEIGHT + row * 40,
+        SORT_BTN_STEP - 7, 36, SORT_NAMES[i], GetAlgoColor(i));
   }
   // Boutons à l'extrémité droite
   screen->btn_stop = CreateButton(WINDOW_WIDTH - 300, 110 + NAVBAR_HEIGHT, 80,
@@ -558,11 +972,13 @@ void TableauxInit(TableauxScreen *screen) {
                                    38, "Graphique", COLOR_NEON_BLUE);
   screen->btn_save = CreateButton(WINDOW_WIDTH - 100, 110 + NAVBAR_HEIGHT, 80,
                                   38, "Save", COLOR_NEON_GREEN);
+  screen->btn_format = CreateButton(WINDOW_WIDTH - 100, 60 + NAVBAR_HEIGHT, 80,
+                                    38, EXPORT_FORMAT_NAMES[EXPORT_TXT],
+                                    COLOR_NEON_GREEN);
 
   screen->manual_input = CreateInputBox(0, 0, 300, 40, 64);
   screen->manual_input_active = false;
-  screen->show_graph = false;
-  screen->history.count = 0;
+  screen->graph_view = GRAPH_HIDDEN;
 }
 
 // ==================== UPDATE ====================
@@ -579,35 +995,43 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
         screen->original_data = (GenericData *)malloc(sizeof(GenericData));
         screen->original_data->type = screen->data_type;
         screen->original_data->size = screen->manual_target_size;
+        screen->original_data->seed = 0; // Saisie manuelle
+        screen->original_data->dist = DIST_UNIFORM;
+        screen->original_data->has_checksum = false;
+        screen->original_data->string_arena = NULL;
+        screen->original_data->arena_size = 0;
+        screen->original_data->mapping = NULL;
+        screen->original_data->mapping_size = 0;
 
         switch (screen->data_type) {
         case DATA_TYPE_INT:
-          screen->original_data->data.int_data = (long long *)malloc(
+          screen->original_data->data.int_data = (long long *)PageAlloc(
               screen->manual_target_size * sizeof(long long));
           memcpy(screen->original_data->data.int_data,
                  screen->manual_int_values,
                  screen->manual_target_size * sizeof(long long));
           break;
         case DATA_TYPE_FLOAT:
-          screen->original_data->data.float_data =
-              (double *)malloc(screen->manual_target_size * sizeof(double));
+          screen->original_data->data.float_data = (double *)PageAlloc(
+              screen->manual_target_size * sizeof(double));
           memcpy(screen->original_data->data.float_data,
                  screen->manual_float_values,
                  screen->manual_target_size * sizeof(double));
           break;
         case DATA_TYPE_CHAR:
           screen->original_data->data.char_data =
-              (char *)malloc(screen->manual_target_size * sizeof(char));
+              (char *)PageAlloc(screen->manual_target_size * sizeof(char));
           memcpy(screen->original_data->data.char_data,
                  screen->manual_char_values,
                  screen->manual_target_size * sizeof(char));
           break;
         case DATA_TYPE_STRING:
-          screen->original_data->data.string_data =
-              (char **)malloc(screen->manual_target_size * sizeof(char *));
+          // Chaînes regroupées dans le bloc des données, saisies libérées
+          SetStringData(screen->original_data, screen->manual_string_values,
+                        screen->manual_target_size);
           for (int i = 0; i < screen->manual_target_size; i++) {
-            screen->original_data->data.string_data[i] =
-                screen->manual_string_values[i];
+            free(screen->manual_string_values[i]);
+            screen->manual_string_values[i] = NULL;
           }
           break;
         }
@@ -615,7 +1039,7 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
         screen->data_size = screen->manual_target_size;
         screen->state = TAB_STATE_HAS_DATA;
         snprintf(screen->status_message, sizeof(screen->status_message),
-                 "Saisie terminee: %d elements", screen->data_size);
+                 "Saisie terminee: %zu elements", screen->data_size);
         screen->status_timer = 3.0f;
       } else {
         // Annulé via X
@@ -684,35 +1108,43 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
             screen->original_data = (GenericData *)malloc(sizeof(GenericData));
             screen->original_data->type = screen->data_type;
             screen->original_data->size = screen->manual_target_size;
+            screen->original_data->seed = 0; // Saisie manuelle
+            screen->original_data->dist = DIST_UNIFORM;
+            screen->original_data->has_checksum = false;
+            screen->original_data->string_arena = NULL;
+            screen->original_data->arena_size = 0;
+            screen->original_data->mapping = NULL;
+            screen->original_data->mapping_size = 0;
 
             switch (screen->data_type) {
             case DATA_TYPE_INT:
-              screen->original_data->data.int_data = (long long *)malloc(
+              screen->original_data->data.int_data = (long long *)PageAlloc(
                   screen->manual_target_size * sizeof(long long));
               memcpy(screen->original_data->data.int_data,
                      screen->manual_int_values,
                      screen->manual_target_size * sizeof(long long));
               break;
             case DATA_TYPE_FLOAT:
-              screen->original_data->data.float_data =
-                  (double *)malloc(screen->manual_target_size * sizeof(double));
+              screen->original_data->data.float_data = (double *)PageAlloc(
+                  screen->manual_target_size * sizeof(double));
               memcpy(screen->original_data->data.float_data,
                      screen->manual_float_values,
                      screen->manual_target_size * sizeof(double));
               break;
             case DATA_TYPE_CHAR:
-              screen->original_data->data.char_data =
-                  (char *)malloc(screen->manual_target_size * sizeof(char));
+              screen->original_data->data.char_data = (char *)PageAlloc(
+                  screen->manual_target_size * sizeof(char));
               memcpy(screen->original_data->data.char_data,
                      screen->manual_char_values,
                      screen->manual_target_size * sizeof(char));
               break;
             case DATA_TYPE_STRING:
-              screen->original_data->data.string_data =
-                  (char **)malloc(screen->manual_target_size * sizeof(char *));
+              // Chaînes regroupées dans le bloc des données, saisies libérées
+              SetStringData(screen->original_data, screen->manual_string_values,
+                            screen->manual_target_size);
               for (int i = 0; i < screen->manual_target_size; i++) {
-                screen->original_data->data.string_data[i] =
-                    screen->manual_string_values[i];
+                free(screen->manual_string_values[i]);
+                screen->manual_string_values[i] = NULL;
               }
               break;
             }
@@ -721,7 +1153,7 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
             screen->state = TAB_STATE_HAS_DATA;
             screen->manual_input_active = false;
             snprintf(screen->status_message, sizeof(screen->status_message),
-                     "Saisie terminee: %d elements", screen->data_size);
+                     "Saisie terminee: %zu elements", screen->data_size);
             screen->status_timer = 3.0f;
             return SCREEN_TABLEAUX;
           }
@@ -851,13 +1283,54 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
 
   AppScreen next_screen = SCREEN_TABLEAUX;
   if (UpdateNavigationBar(&next_screen)) {
+    CancelSizeSweep(&screen->sweep);
     StopAllSorts(&screen->sort_manager);
     ResetScreen(screen);
+    ReleaseSortBuffers(&screen->sort_manager);
     return next_screen;
   }
 
+  // Tableau -> progression -> historique -> tableau
   if (UpdateButton(&screen->btn_graph)) {
-    screen->show_graph = !screen->show_graph;
+    screen->graph_view = (GraphView)((screen->graph_view + 1) % 3);
+  }
+
+  if (UpdateButton(&screen->btn_bench) && screen->state != TAB_STATE_SORTING &&
+      !screen->type_dropdown_open) {
+    screen->bench_reps_index =
+        (screen->bench_reps_index + 1) % BENCH_REPS_COUNT;
+  }
+
+  // Balayage 1k -> 10M du type et de la distribution courants; les tailles
+  // terminées alimentent l'historique au fil de l'eau
+  if (UpdateButton(&screen->btn_sweep) && !screen->type_dropdown_open) {
+    if (screen->sweep.active) {
+      CancelSizeSweep(&screen->sweep);
+      AddSweepPoints(screen);
+      snprintf(screen->status_message, sizeof(screen->status_message),
+               "Balayage interrompu (%d tailles)", screen->sweep_consumed);
+      screen->status_timer = 3.0f;
+    } else if (screen->state != TAB_STATE_SORTING) {
+      SizeSweep *sw = &screen->sweep;
+      sw->type = screen->data_type;
+      sw->dist = screen->data_dist;
+      sw->seed = (unsigned long long)time(NULL);
+      sw->min_size = SWEEP_MIN_SIZE;
+      sw->max_size = SWEEP_MAX_SIZE;
+      sw->budget = SWEEP_DEFAULT_BUDGET;
+      screen->sweep_consumed = 0;
+      StartSizeSweep(sw);
+      screen->graph_view = GRAPH_HISTORY;
+    }
+  }
+  AddSweepPoints(screen);
+  if (PollSizeSweep(&screen->sweep)) {
+    AddSweepPoints(screen);
+    snprintf(screen->status_message, sizeof(screen->status_message),
+             screen->sweep.ok ? "Balayage termine: %d tailles"
+                              : "Balayage arrete (memoire): %d tailles",
+             screen->sweep_consumed);
+    screen->status_timer = 3.0f;
   }
 
   UpdateTypeDropdown(screen, 160, 60 + NAVBAR_HEIGHT);
@@ -868,11 +1341,24 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
     int size = atoi(screen->input_size.text);
     if (size > 0) {
       ResetScreen(screen);
-      screen->data_size = size;
-      screen->original_data = GenerateTypedData(size, screen->data_type);
-      screen->state = TAB_STATE_HAS_DATA;
-      snprintf(screen->status_message, sizeof(screen->status_message),
-               "%d %s generes", size, TYPE_NAMES[screen->data_type]);
+      // Nouvelle graine à chaque génération, affichée pour pouvoir rejouer
+      // la même entrée avec bench_sort --seed
+      unsigned long long seed = (unsigned long long)time(NULL) * 1000003ULL +
+                                (unsigned long long)(GetTime() * 1000000.0);
+      screen->original_data = GenerateTypedData(size, screen->data_type,
+                                                screen->data_dist, seed);
+      if (screen->original_data) {
+        screen->data_size = size;
+        screen->state = TAB_STATE_HAS_DATA;
+        snprintf(screen->status_message, sizeof(screen->status_message),
+                 "%d %s generes, %s (graine %llu)", size,
+                 TYPE_NAMES[screen->data_type], DIST_NAMES[screen->data_dist],
+                 seed);
+      } else {
+        snprintf(screen->status_message, sizeof(screen->status_message),
+                 "Memoire insuffisante pour %d %s", size,
+                 TYPE_NAMES[screen->data_type]);
+      }
       screen->status_timer = 3.0f;
     }
   }
@@ -900,114 +1386,114 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
     }
   }
 
+  // Jeu de données binaire: projeté en mémoire, sans analyse des valeurs
+  if (UpdateButton(&screen->btn_import) && screen->state != TAB_STATE_SORTING &&
+      !screen->type_dropdown_open) {
+    double start = GetTime();
+    GenericData *data = LoadDataset(DATASET_FILE);
+    if (data) {
+      ResetScreen(screen);
+      screen->original_data = data;
+      screen->data_size = data->size;
+      screen->data_type = data->type;
+      screen->data_dist = data->dist;
+      screen->btn_generate.text = DIST_NAMES[data->dist];
+      snprintf(screen->input_size.text, sizeof(screen->input_size.text), "%zu",
+               data->size);
+      screen->input_size.cursor = strlen(screen->input_size.text);
+      screen->state = TAB_STATE_HAS_DATA;
+      snprintf(screen->status_message, sizeof(screen->status_message),
+               "%zu %s importes en %.1f ms", data->size,
+               TYPE_NAMES[data->type], (GetTime() - start) * 1000.0);
+    } else {
+      snprintf(screen->status_message, sizeof(screen->status_message),
+               "Import impossible: %s absent ou invalide", DATASET_FILE);
+    }
+    screen->status_timer = 3.0f;
+  }
+
+  if (UpdateButton(&screen->btn_export) && screen->original_data &&
+      !screen->type_dropdown_open) {
+    if (SaveDataset(screen->original_data, DATASET_FILE))
+      snprintf(screen->status_message, sizeof(screen->status_message),
+               "Donnees exportees dans %s", DATASET_FILE);
+    else
+      snprintf(screen->status_message, sizeof(screen->status_message),
+               "Export impossible: %s", DATASET_FILE);
+    screen->status_timer = 3.0f;
+  }
+
   if (!screen->type_dropdown_open) {
     for (int i = 0; i < SORT_COUNT; i++) {
+      // Pas de tri pendant un balayage: les mesures se perturberaient
       if (UpdateButton(&screen->btn_sort[i]) &&
-          screen->state == TAB_STATE_HAS_DATA) {
-        ClearSortedData(screen);
-        screen->state = TAB_STATE_SORTING;
+          screen->state == TAB_STATE_HAS_DATA && !screen->sweep.active) {
+        // Un tri simple est une mesure unique, sans chauffe
+        int reps = BENCH_REPS[screen->bench_reps_index];
         screen->selected_sort = i;
-        StartAllSorts(&screen->sort_manager, screen->original_data);
-        screen->global_start_time = GetTime();
-
-        for (int j = 0; j < SORT_COUNT; j++) {
-          screen->sort_start_times[j] = screen->global_start_time;
-          screen->sort_running[j] = true;
-          screen->sort_done[j] = false;
-          screen->sort_progress_count[j] = 0; // Reset progress tracking
-        }
+        screen->bench_warmup = reps > 1 ? BENCH_WARMUP : 0;
+        screen->bench_total = screen->bench_warmup + reps;
+        screen->bench_run = 0;
+        LaunchSortPass(screen);
       }
     }
   }
 
   if (UpdateButton(&screen->btn_stop) && screen->state == TAB_STATE_SORTING) {
     StopAllSorts(&screen->sort_manager);
+    TrimSortBuffers(&screen->sort_manager);
     for (int i = 0; i < SORT_COUNT; i++)
       screen->sort_running[i] = false;
     screen->state = TAB_STATE_HAS_DATA;
   }
 
-  // Bouton sauvegarder les résultats
-  if (UpdateButton(&screen->btn_save) && !screen->type_dropdown_open) {
-    FILE *f = fopen("resultats_tri.txt", "w");
-    if (f) {
-      fprintf(f, "========================================\n");
-      fprintf(f, "RESULTATS DES TRIS\n");
-      fprintf(f, "========================================\n");
-      fprintf(f, "Taille du tableau: %d elements\n", screen->data_size);
-      fprintf(f, "Type de donnees: %s\n", TYPE_NAMES[screen->data_type]);
-      fprintf(f, "\n--- TEMPS DE TRI ---\n");
-
-      for (int i = 0; i < SORT_COUNT; i++) {
-        if (screen->sort_done[i]) {
-          fprintf(f, "%-15s : %.3f ms\n", SORT_NAMES[i],
-                  screen->sort_times[i] * 1000.0);
-        } else if (screen->sort_running[i]) {
-          fprintf(f, "%-15s : En cours...\n", SORT_NAMES[i]);
-        } else {
-          fprintf(f, "%-15s : Non execute\n", SORT_NAMES[i]);
-        }
-      }
-
-      // Sauvegarder le tableau AVANT tri
-      fprintf(f, "\n--- DONNEES AVANT TRI ---\n");
-      if (screen->original_data && screen->original_data->size > 0) {
-        for (int i = 0; i < screen->original_data->size; i++) {
-          switch (screen->original_data->type) {
-          case DATA_TYPE_INT:
-            fprintf(f, "%lld", screen->original_data->data.int_data[i]);
-            break;
-          case DATA_TYPE_FLOAT:
-            fprintf(f, "%.2f", screen->original_data->data.float_data[i]);
-            break;
-          case DATA_TYPE_CHAR:
-            fprintf(f, "%c", screen->original_data->data.char_data[i]);
-            break;
-          case DATA_TYPE_STRING:
-            fprintf(f, "%s", screen->original_data->data.string_data[i]);
-            break;
-          }
-          if (i < screen->original_data->size - 1)
-            fprintf(f, ", ");
-          if ((i + 1) % 10 == 0)
-            fprintf(f, "\n");
-        }
-        fprintf(f, "\n");
-      }
-
-      // Sauvegarder le tableau APRES tri
-      fprintf(f, "\n--- DONNEES APRES TRI ---\n");
-      if (screen->display_sorted && screen->display_sorted->size > 0) {
-        for (int i = 0; i < screen->display_sorted->size; i++) {
-          switch (screen->display_sorted->type) {
-          case DATA_TYPE_INT:
-            fprintf(f, "%lld", screen->display_sorted->data.int_data[i]);
-            break;
-          case DATA_TYPE_FLOAT:
-            fprintf(f, "%.2f", screen->display_sorted->data.float_data[i]);
-            break;
-          case DATA_TYPE_CHAR:
-            fprintf(f, "%c", screen->display_sorted->data.char_data[i]);
-            break;
-          case DATA_TYPE_STRING:
-            fprintf(f, "%s", screen->display_sorted->data.string_data[i]);
-            break;
-          }
-          if (i < screen->display_sorted->size - 1)
-            fprintf(f, ", ");
-          if ((i + 1) % 10 == 0)
-            fprintf(f, "\n");
-        }
-        fprintf(f, "\n");
-      }
+  if (UpdateButton(&screen->btn_format) && !screen->type_dropdown_open) {
+    screen->export_format =
+        (ExportFormat)((screen->export_format + 1) % EXPORT_FORMAT_COUNT);
+    screen->btn_format.text = EXPORT_FORMAT_NAMES[screen->export_format];
+  }
 
-      fprintf(f, "\n========================================\n");
-      fclose(f);
+  // Bouton sauvegarder les résultats: écriture dans un thread, l'UI ne fait
+  // que recopier les temps (les données restent en place jusqu'à la fin)
+  if (UpdateButton(&screen->btn_save) && !screen->type_dropdown_open &&
+      !screen->export_job.active) {
+    ResultExport *ex = &screen->export_job;
+    ex->format = screen->export_format;
+    snprintf(ex->path, sizeof(ex->path), "resultats_tri%s",
+             EXPORT_EXTENSIONS[ex->format]);
+    ex->type = screen->data_type;
+    ex->size = screen->data_size;
+    ex->before = screen->original_data;
+    ex->after = screen->display_sorted;
 
-      snprintf(screen->status_message, sizeof(screen->status_message),
-               "Resultats sauvegardes dans resultats_tri.txt");
-      screen->status_timer = 3.0f;
+    for (int i = 0; i < SORT_COUNT; i++) {
+      ExportResult *r = &ex->results[i];
+      r->status = EXPORT_NOT_RUN;
+      if (screen->sort_done[i] && screen->sort_times[i] < 0)
+        r->status = EXPORT_NOT_APPLICABLE;
+      else if (screen->sort_done[i])
+        r->status = EXPORT_DONE;
+      else if (screen->sort_running[i])
+        r->status = EXPORT_RUNNING;
+      r->time_ms = screen->sort_times[i] * 1000.0;
+      r->isa = SortKernelIsa(i, screen->data_type);
+      snprintf(r->note, sizeof(r->note), "%s",
+               screen->sort_manager.threads[i].note);
+      if (r->status == EXPORT_DONE)
+        r->counters = screen->sort_manager.threads[i].counters;
+      else
+        HwCountersClear(&r->counters);
     }
+    StartResultExport(ex);
+  }
+
+  bool export_ok;
+  if (PollResultExport(&screen->export_job, &export_ok)) {
+    snprintf(screen->status_message, sizeof(screen->status_message),
+             export_ok ? "Resultats sauvegardes dans %s"
+                       : "Echec de la sauvegarde: %s",
+             screen->export_job.path);
+    screen->status_timer = 3.0f;
   }
 
   if (screen->state == TAB_STATE_SORTING) {
@@ -1015,14 +1501,23 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
     screen->elapsed_time = now - screen->global_start_time;
 
     bool all_done = true;
+    bool any_running = false;
     for (int i = 0; i < SORT_COUNT; i++) {
-      if (screen->sort_manager.threads[i].completed && !screen->sort_done[i]) {
+      // Un tri pas encore lancé garde le drapeau de la passe précédente
+      if (screen->sort_running[i] &&
+          screen->sort_manager.threads[i].completed && !screen->sort_done[i]) {
         screen->sort_done[i] = true;
         screen->sort_running[i] = false;
         screen->sort_times[i] = screen->sort_manager.threads[i].elapsed_time;
+        if (screen->sort_manager.threads[i].verify != SORT_VERIFY_OK) {
+          snprintf(screen->status_message, sizeof(screen->status_message),
+                   "Verification echouee pour %s: %s", SORT_NAMES[i],
+                   SORT_VERIFY_NAMES[screen->sort_manager.threads[i].verify]);
+          screen->status_timer = 5.0f;
+        }
+        // Affichage direct du tampon du tri (pas de copie supplémentaire)
         if (i == screen->selected_sort) {
-          screen->display_sorted =
-              CopyGenericData(screen->sort_manager.threads[i].data);
+          screen->display_sorted = screen->sort_manager.threads[i].data;
         }
       }
       if (screen->sort_running[i]) {
@@ -1034,32 +1529,34 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
           double lastT = (pc > 0) ? screen->sort_progress_times[i][pc - 1] : 0;
           if (screen->sort_elapsed[i] - lastT >= 0.05) { // 50ms
             screen->sort_progress_times[i][pc] = screen->sort_elapsed[i];
-            // Estimer la progression (basée sur le temps relatif)
-            float estimatedProgress =
-                (float)(screen->sort_elapsed[i] * 0.5); // Approximation
-            if (estimatedProgress > 0.95f)
-              estimatedProgress = 0.95f;
-            screen->sort_progress_values[i][pc] = estimatedProgress;
+            // Progression publiée par le noyau de tri
+            screen->sort_progress_values[i][pc] =
+                SortThreadProgress(&screen->sort_manager.threads[i]);
             screen->sort_progress_count[i]++;
           }
         }
 
         all_done = false;
+        any_running = true;
       }
       if (!screen->sort_done[i])
         all_done = false;
     }
 
+    // Mode benchmark: algorithme suivant quand le précédent est fini
+    if (!all_done && !any_running)
+      StartNextSort(screen);
+
     if (all_done) {
-      screen->state = TAB_STATE_DONE;
-      if (screen->history.count < 20) {
-        int idx = screen->history.count;
-        screen->history.sizes[idx] = screen->data_size;
-        for (int a = 0; a < SORT_COUNT; a++) {
-          screen->history.times[a][idx] = screen->sort_times[a];
-        }
-        screen->history.count++;
-      }
+      // Passe terminée: temps conservés hors chauffe, même entrée rejouée
+      int rep = screen->bench_run - screen->bench_warmup;
+      for (int a = 0; a < SORT_COUNT && rep >= 0; a++)
+        screen->bench_samples[a][rep] = screen->sort_times[a];
+      screen->bench_run++;
+      if (screen->bench_run < screen->bench_total)
+        LaunchSortPass(screen);
+      else
+        FinishSortRun(screen);
     }
   }
 
@@ -1067,7 +1564,8 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
     screen->status_timer -= dt;
 
   float wheel = GetMouseWheelMove();
-  if (wheel != 0 && !screen->type_dropdown_open && !screen->show_graph) {
+  if (wheel != 0 && !screen->type_dropdown_open &&
+      screen->graph_view == GRAPH_HIDDEN) {
     Vector2 mouse = GetMousePosition();
     float panelWidth = (WINDOW_WIDTH - 50) / 2.0f;
     Rectangle beforeRect = {20, 175, panelWidth, 320};
@@ -1090,6 +1588,61 @@ AppScreen TableauxUpdate(TableauxScreen *screen) {
 
 // ==================== DRAW ====================
 
+// Compteur matériel abrégé (k, M, G), "n/a" si indisponible
+static void FormatCounter(long long value, char *buffer, int buf_size) {
+  if (value == HW_COUNTER_NA)
+    snprintf(buffer, buf_size, "n/a");
+  else if (value >= 1000000000LL)
+    snprintf(buffer, buf_size, "%.2fG", value / 1e9);
+  else if (value >= 1000000LL)
+    snprintf(buffer, buf_size, "%.2fM", value / 1e6);
+  else if (value >= 1000LL)
+    snprintf(buffer, buf_size, "%.1fk", value / 1e3);
+  else
+    snprintf(buffer, buf_size, "%lld", value);
+}
+
+// Infobulle d'un résultat: dispersion des répétitions (mode Bench) et
+// compteurs matériels, une ligne chacun
+static void DrawResultTooltip(const SortStats *stats,
+                              const HwCounterSample *counters) {
+  static const char *labels[HW_COUNTER_COUNT] = {
+      "cycles", "instr", "br-miss", "cache-miss", "pf", "pf-maj"};
+  char lines[2][160];
+  int lineCount = 0;
+
+  if (stats->count > 1) {
+    char low[32], high[32];
+    FormatTimeString(stats->ci_low, low, sizeof(low));
+    FormatTimeString(stats->ci_high, high, sizeof(high));
+    snprintf(lines[lineCount++], sizeof(lines[0]),
+             "n=%d  IC95 [%s ; %s]  ecart type %.1f%%", stats->count, low,
+             high, stats->median > 0 ? 100.0 * stats->stddev / stats->median
+                                     : 0.0);
+  }
+
+  int len = 0;
+  for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+    char value[24]; // "%lld" négatif: jusqu'à 21 octets
+    FormatCounter(counters->value[c], value, sizeof(value));
+    len += snprintf(lines[lineCount] + len, sizeof(lines[0]) - len, "%s%s %s",
+                    c ? "  " : "", labels[c], value);
+  }
+  lineCount++;
+
+  int width = 0;
+  for (int l = 0; l < lineCount; l++) {
+    int w = MeasureText(lines[l], 10) + 20;
+    width = w > width ? w : width;
+  }
+  Vector2 mouse = GetMousePosition();
+  float x = fminf(mouse.x + 10, WINDOW_WIDTH - width - 4);
+  float y = mouse.y - 10 - lineCount * 16;
+  DrawRectangle(x, y, width, lineCount * 16 + 9, Fade(BLACK, 0.8f));
+  for (int l = 0; l < lineCount; l++)
+    DrawText(lines[l], x + 10, y + 5 + l * 16, 10, WHITE);
+}
+
 void TableauxDraw(TableauxScreen *screen) {
   DrawRectangleGradientV(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, COLOR_BG_DARK,
                          COLOR_BG_LIGHT);
@@ -1102,6 +1655,20 @@ void TableauxDraw(TableauxScreen *screen) {
   DrawText("Type:", 160, 45 + NAVBAR_HEIGHT, 12, COLOR_TEXT_DIM);
   DrawButton(&screen->btn_generate);
   DrawButton(&screen->btn_manual);
+  DrawButton(&screen->btn_import);
+  DrawButton(&screen->btn_export);
+  snprintf(screen->bench_label, sizeof(screen->bench_label), "Bench x%d",
+           BENCH_REPS[screen->bench_reps_index]);
+  screen->btn_bench.text = screen->bench_label;
+  DrawButton(&screen->btn_bench);
+  if (screen->sweep.active) {
+    snprintf(screen->sweep_label, sizeof(screen->sweep_label), "%d%%",
+             (int)(SizeSweepProgress(&screen->sweep) * 100));
+    screen->btn_sweep.text = screen->sweep_label;
+  } else {
+    screen->btn_sweep.text = "Sweep";
+  }
+  DrawButton(&screen->btn_sweep);
 
   DrawText("Algorithmes (cliquez pour trier):", 20, 95 + NAVBAR_HEIGHT, 12,
            COLOR_TEXT_DIM);
@@ -1109,10 +1676,26 @@ void TableauxDraw(TableauxScreen *screen) {
     DrawButton(&screen->btn_sort[i]);
   DrawButton(&screen->btn_stop);
 
-  screen->btn_graph.text = screen->show_graph ? "< Tableau" : "Graphique";
-  screen->btn_graph.color =
-      screen->show_graph ? COLOR_NEON_ORANGE : COLOR_NEON_BLUE;
+  static const char *GRAPH_LABELS[] = {"Graphique", "Historique", "< Tableau"};
+  screen->btn_graph.text = GRAPH_LABELS[screen->graph_view];
+  screen->btn_graph.color = screen->graph_view != GRAPH_HIDDEN
+                                ? COLOR_NEON_ORANGE
+                                : COLOR_NEON_BLUE;
   DrawButton(&screen->btn_graph);
+  DrawButton(&screen->btn_format);
+  if (screen->export_job.active) {
+    // Progression de la sauvegarde sous le bouton
+    Rectangle bar = screen->btn_save.bounds;
+    float progress = ResultExportProgress(&screen->export_job);
+    DrawRectangle(bar.x, bar.y + bar.height + 3, bar.width, 4, COLOR_PANEL);
+    DrawRectangle(bar.x, bar.y + bar.height + 3, bar.width * progress, 4,
+                  COLOR_NEON_GREEN);
+    snprintf(screen->save_label, sizeof(screen->save_label), "%d%%",
+             (int)(progress * 100));
+    screen->btn_save.text = screen->save_label;
+  } else {
+    screen->btn_save.text = "Save";
+  }
   DrawButton(&screen->btn_save);
 
   if (screen->status_timer > 0) {
@@ -1123,7 +1706,7 @@ void TableauxDraw(TableauxScreen *screen) {
              msgColor);
   }
 
-  if (screen->show_graph) {
+  if (screen->graph_view != GRAPH_HIDDEN) {
     DrawPerformanceGraph(screen,
                          (Rectangle){20, 190 + NAVBAR_HEIGHT, WINDOW_WIDTH - 40,
                                      WINDOW_HEIGHT - 210 - NAVBAR_HEIGHT});
@@ -1143,11 +1726,12 @@ void TableauxDraw(TableauxScreen *screen) {
                             WINDOW_HEIGHT - 530 - NAVBAR_HEIGHT};
     DrawPanel(statusRect, "Resultats", COLOR_NEON_PURPLE);
 
-    float colWidth = (statusRect.width - 40) / SORT_COUNT;
+    float colWidth = (statusRect.width - 40) / SORT_PER_ROW;
+    int hovered = -1;
 
     for (int i = 0; i < SORT_COUNT; i++) {
-      float x = statusRect.x + 20 + i * colWidth;
-      float y = statusRect.y + 28;
+      float x = statusRect.x + 20 + (i % SORT_PER_ROW) * colWidth;
+      float y = statusRect.y + 28 + (i / SORT_PER_ROW) * 62;
 
       bool isSelected =
           (i == screen->selected_sort && screen->state != TAB_STATE_IDLE);
@@ -1156,16 +1740,53 @@ void TableauxDraw(TableauxScreen *screen) {
         // StatusRect y=510, h=85 -> max Y = 595
         // y = 538.
         // Hauteur max dispo sous y: 595 - 530 = ~65px
-        Rectangle selRect = {x - 8, y - 6, colWidth - 15, 60};
+        Rectangle selRect = {x - 8, y - 6, colWidth - 15, 58};
         DrawRectRoundedLinesThick(selRect, 0.15f, 4, 3, GetAlgoColor(i));
       }
 
       DrawText(SORT_NAMES[i], x, y, 14, GetAlgoColor(i));
 
       char timeStr[32];
-      if (screen->sort_done[i]) {
+      if (screen->sort_done[i] && screen->sort_times[i] < 0) {
+        DrawText("N/A", x, y + 22, 18, COLOR_TEXT_DIM);
+      } else if (screen->sort_done[i]) {
         FormatTimeString(screen->sort_times[i], timeStr, sizeof(timeStr));
         DrawText(timeStr, x, y + 22, 18, COLOR_NEON_GREEN);
+        const char *isa = SortKernelIsa(i, screen->data_type);
+        int isaX = x + MeasureText(timeStr, 18) + 8;
+        DrawText(isa, isaX, y + 27, 11, COLOR_TEXT_DIM);
+
+        // Instructions par cycle (détail des compteurs au survol)
+        const HwCounterSample *counters =
+            &screen->sort_manager.threads[i].counters;
+        if (HwCountersIpc(counters) > 0) {
+          char ipcStr[16];
+          snprintf(ipcStr, sizeof(ipcStr), "IPC %.2f", HwCountersIpc(counters));
+          DrawText(ipcStr, isaX + MeasureText(isa, 11) + 8, y + 27, 11,
+                   COLOR_TEXT_DIM);
+        }
+        if (CheckCollisionPointRec(
+                GetMousePosition(),
+                (Rectangle){x - 8, y - 6, colWidth - 15, 58}))
+          hovered = i;
+
+        // Tri faux (ordre ou éléments): signalé avant toute autre note
+        if (screen->sort_manager.threads[i].verify != SORT_VERIFY_OK) {
+          DrawText(screen->sort_manager.threads[i].note, x, y + 42, 11,
+                   COLOR_NEON_RED);
+        } else if (i == SORT_PARALLEL && screen->sort_done[SORT_QUICK] &&
+                   screen->sort_times[i] > 0) {
+          // Accélération du tri multi-cœurs par rapport à Quick Sort
+          char speedStr[48];
+          snprintf(speedStr, sizeof(speedStr), "x%.2f vs Quick (%d thr)",
+                   screen->sort_times[SORT_QUICK] / screen->sort_times[i],
+                   GetSortThreadCount());
+          DrawText(speedStr, x, y + 42, 11, COLOR_TEXT_DIM);
+        } else if (screen->sort_manager.threads[i].note[0]) {
+          // Décision de l'algorithme (ex: dénombrement ou introsort)
+          DrawText(screen->sort_manager.threads[i].note, x, y + 42, 11,
+                   COLOR_TEXT_DIM);
+        }
       } else if (screen->sort_running[i]) {
         FormatTimeString(screen->sort_elapsed[i], timeStr, sizeof(timeStr));
         DrawText(timeStr, x, y + 22, 18, (Color){255, 193, 7, 255});
@@ -1175,10 +1796,19 @@ void TableauxDraw(TableauxScreen *screen) {
       }
     }
 
+    if (hovered >= 0)
+      DrawResultTooltip(&screen->sort_stats[hovered],
+                        &screen->sort_manager.threads[hovered].counters);
+
     if (screen->original_data) {
-      char infoStr[80];
-      snprintf(infoStr, sizeof(infoStr), "%d elements  |  Type: %s",
-               screen->data_size, TYPE_NAMES[screen->data_type]);
+      char infoStr[128];
+      int len = snprintf(infoStr, sizeof(infoStr), "%zu elements  |  Type: %s",
+                         screen->data_size, TYPE_NAMES[screen->data_type]);
+      if (screen->state == TAB_STATE_SORTING && screen->bench_total > 1)
+        snprintf(infoStr + len, sizeof(infoStr) - len,
+                 "  |  Bench: passe %d/%d (%d de chauffe)",
+                 screen->bench_run + 1, screen->bench_total,
+                 screen->bench_warmup);
       DrawText(infoStr, 20, WINDOW_HEIGHT - 22, 13, COLOR_TEXT_MAIN);
     }
   }
@@ -1191,6 +1821,13 @@ void TableauxDraw(TableauxScreen *screen) {
 }
 
 void TableauxUnload(TableauxScreen *screen) {
+  CancelSizeSweep(&screen->sweep);
   StopAllSorts(&screen->sort_manager);
   ResetScreen(screen);
+  free(screen->history.points);
+  screen->history.points = NULL;
+  screen->history.count = screen->history.capacity = 0;
+  ReleaseSortBuffers(&screen->sort_manager);
+  DestroySortPool(screen->sort_manager.pool);
+  screen->sort_manager.pool = NULL;
 }
@@ -7,7 +7,9 @@
 
 #include "../theme.h"
 #include "../ui_common.h"
+#include "export.h"
 #include "sorting.h"
+#include "sweep.h"
 
 // ==================== ÉTAT DU MODULE ====================
 
@@ -25,25 +27,44 @@ typedef enum {
   INPUT_MODE_MANUAL
 } InputMode;
 
-// Historique pour le graphique
+// Mesure d'une entrée: statistiques par algorithme (count = 0: non mesuré)
 typedef struct {
-  int sizes[20];
-  double times[SORT_COUNT][20];
+  size_t size;
+  DataType type;
+  DataDistribution dist;
+  SortStats stats[SORT_COUNT];
+} PerformancePoint;
+
+// Historique pour le graphique, trié par taille (capacité doublée au besoin)
+typedef struct {
+  PerformancePoint *points;
   int count;
+  int capacity;
 } PerformanceHistory;
 
+// Vue affichée à la place des panneaux de données
+typedef enum {
+  GRAPH_HIDDEN,
+  GRAPH_PROGRESS, // Progression des tris en cours
+  GRAPH_HISTORY   // Temps médian par taille, barres d'erreur
+} GraphView;
+
+// Répétitions mesurées max d'un benchmark
+#define TAB_BENCH_MAX_REPS 30
+
 // Structure principale du module
 typedef struct {
   // État
   TableauxState state;
-  DataType data_type; // Type de données actuel
+  DataType data_type;         // Type de données actuel
+  DataDistribution data_dist; // Distribution des données générées
   InputMode input_mode;
 
   // Données génériques
   GenericData *original_data; // Données originales
   GenericData
-      *display_sorted; // Données triées pour affichage (algo sélectionné)
-  int data_size;
+      *display_sorted; // Tampon trié affiché (emprunté au SortManager)
+  size_t data_size;
 
   // Gestionnaire de tri parallèle
   SortManager sort_manager;
@@ -71,6 +92,11 @@ typedef struct {
   Button btn_stop;     // Arrêter les tris
   Button btn_graph;    // Afficher graphique
   Button btn_save;     // Sauvegarder résultats
+  Button btn_format;   // Format de sauvegarde (TXT, CSV, JSON)
+  Button btn_import;   // Charger un jeu de données binaire
+  Button btn_export;   // Enregistrer les données au format binaire
+  Button btn_bench;    // Répétitions par tri (x1 = tri simple)
+  Button btn_sweep;    // Balayage de tailles (analyse de complexité)
 
   // UI - Dropdown type de données
   Button btn_type_dropdown; // Bouton principal du dropdown
@@ -96,9 +122,28 @@ typedef struct {
   char status_message[128];
   float status_timer;
 
+  // Sauvegarde des résultats en arrière-plan
+  ResultExport export_job;
+  ExportFormat export_format;
+  char save_label[8]; // Texte du bouton Save pendant l'export ("42%")
+
+  // Mode benchmark: passes de chauffe puis répétitions sur la même entrée
+  int bench_reps_index; // Choix courant du bouton Bench
+  int bench_warmup;     // Passes ignorées du lancement en cours
+  int bench_run;        // Passe en cours (chauffe comprise)
+  int bench_total;      // Passes prévues
+  double bench_samples[SORT_COUNT][TAB_BENCH_MAX_REPS];
+  SortStats sort_stats[SORT_COUNT]; // Statistiques du dernier lancement
+  char bench_label[16];
+
+  // Balayage de tailles en arrière-plan, versé dans l'historique
+  SizeSweep sweep;
+  int sweep_consumed; // Lignes du balayage déjà ajoutées à l'historique
+  char sweep_label[8];
+
   // Graphique performance
   PerformanceHistory history;
-  bool show_graph;
+  GraphView graph_view;
 
   // Scroll pour affichage des données
   float scroll_before_y; // Scroll zone "Avant"
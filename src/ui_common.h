@@ -68,6 +68,9 @@ void DrawTextCentered(const char *text, int y, int fontSize, Color color);
 void DrawTextGlow(const char *text, int x, int y, int fontSize, Color color,
                   float glowIntensity);
 
+// Dessine une infobulle d'une ligne près du curseur
+void DrawTooltip(const char *text);
+
 // ==================== INPUTS ====================
 
 typedef struct {